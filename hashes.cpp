@@ -1,89 +1,131 @@
-#include <bitset>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
-#include <cmath>
-#include <climits>
+#include <chrono>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include "hashes.h"
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
 /*
-  128 bit unsigned integer type used for hashes that work with
-  much larger numbers
+  128 bit unsigned integer type used to encode the message length at the end
+  of the final block of hashes that work with much larger numbers
 
   Used in:
   - SHA384, SHA512, SHA512/224, SHA512/256
 */
 typedef unsigned int uint128_t __attribute__((mode(TI)));
 
-const uint128_t bigModulo = 18446744073709551615 + 1; // Used to handle modulo 2^64
-                                                      // operations
-
 /*
-  Performs a rotational right shift on the bits of the passed 32 bit word
+  Finds the nth prime number (starting with 2 as the 1st) by trial division.
+  Only meant to be evaluated at compile time.
 
   Used in:
-  - SHA256
+  - SHA224, SHA256
 */
-void rotationalRightShift(bool word[32], uint32_t val, unsigned int count) {
-  const unsigned int mask = (CHAR_BIT*sizeof(val) - 1);
-
-  count &= mask;
+constexpr uint64_t nthPrime(int n) {
+  uint64_t candidate = 1;
 
-  uint32_t rotVal = (val >> count) | (val << ( (-count) & mask ));
+  while(n > 0) {
+    ++candidate;
 
-  short wordPos = 0;
-  for(short bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = rotVal & (1l << bitPos);
+    bool prime = true;
+    for(uint64_t divisor = 2; divisor * divisor <= candidate; ++divisor)
+      if(candidate % divisor == 0) {
+        prime = false;
+        break;
+      }
 
-    word[wordPos++] = bit;
+    if(prime)
+      --n;
   }
+
+  return candidate;
 }
 
 /*
-  Performs a rotational right shift on the bits of the passed 64 bit word
+  Integer square and cube roots, rounded down, found by binary search. The
+  search is limited to 2^36 so the tested value never overflows, which covers
+  every value these are used with. Only meant to be evaluated at compile time.
 
   Used in:
-  - SHA384, SHA512, SHA512/224, SHA512/256
+  - SHA224, SHA256
 */
-void rotationalRightShift64(bool word[64], uint64_t val, unsigned int count) {
-  const unsigned int mask = (CHAR_BIT*sizeof(val) - 1);
+constexpr uint64_t integerSquareRoot(uint128_t val) {
+  uint64_t low = 0;
+  uint64_t high = 1ull << 36;
+
+  while(low + 1 < high) {
+    uint64_t mid = (low + high) / 2;
+
+    if((uint128_t)mid * mid <= val)
+      low = mid;
+    else
+      high = mid;
+  }
 
-  count &= mask;
+  return low;
+}
 
-  uint64_t rotVal = (val >> count) | (val << ( (-count) & mask ));
+constexpr uint64_t integerCubeRoot(uint128_t val) {
+  uint64_t low = 0;
+  uint64_t high = 1ull << 36;
 
-  short wordPos = 0;
-  for(short bitPos = 63; bitPos >= 0; --bitPos) {
-    bool bit = rotVal & (1l << bitPos);
+  while(low + 1 < high) {
+    uint64_t mid = (low + high) / 2;
 
-    word[wordPos++] = bit;
+    if((uint128_t)mid * mid * mid <= val)
+      low = mid;
+    else
+      high = mid;
   }
+
+  return low;
 }
 
 /*
-  Performs a rotational left shift on the bits of the passed word
+  Performs a rotational right shift on the bits of the passed 32 bit word
 
   Used in:
-  - MD4, SHA0, SHA1
+  - SHA224, SHA256
 */
-void rotationalLeftShift(bool word[32], uint32_t val, unsigned int count) {
-  const unsigned int mask = (CHAR_BIT*sizeof(val) - 1);
+inline uint32_t rotationalRightShift(uint32_t val, unsigned int count) {
+  return (val >> count) | (val << ((-count) & 31));
+}
 
-  count &= mask;
+/*
+  Performs a rotational right shift on the bits of the passed 64 bit word
 
-  uint32_t rotVal = (val << count) | (val >> ( (-count) & mask));
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
+*/
+inline uint64_t rotationalRightShift64(uint64_t val, unsigned int count) {
+  return (val >> count) | (val << ((-count) & 63));
+}
 
-  short wordPos = 0;
-  for(short bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = rotVal & (1l << bitPos);
+/*
+  Performs a rotational left shift on the bits of the passed 32 bit word
 
-    word[wordPos++] = bit;
-  }
+  Used in:
+  - MD4, MD5, SHA0, SHA1
+*/
+inline uint32_t rotationalLeftShift(uint32_t val, unsigned int count) {
+  return (val << count) | (val >> ((-count) & 31));
 }
 
 /*
@@ -93,17 +135,10 @@ void rotationalLeftShift(bool word[32], uint32_t val, unsigned int count) {
   (x and y) or (not x and z)
 
   Used in:
-  - MD4, MD5, SHA0
+  - MD4, MD5
 */
-void oldChoice(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = (val1 & val2) | ( (~val1) & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t oldChoice(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return (val1 & val2) | ((~val1) & val3);
 }
 
 /*
@@ -115,15 +150,8 @@ void oldChoice(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
   Used in:
   - MD5
 */
-void choiceVariant(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = (val1 & val3) | (val2 & ~(val3) );
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t choiceVariant(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return (val1 & val3) | (val2 & ~(val3));
 }
 
 /*
@@ -135,15 +163,8 @@ void choiceVariant(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
   Used in:
   - MD5
 */
-void weirdChoiceVariant(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = val2 ^ ( val1 | ~(val3) );
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t weirdChoiceVariant(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return val2 ^ (val1 | ~(val3));
 }
 
 /*
@@ -153,17 +174,10 @@ void weirdChoiceVariant(bool word[32], uint32_t val1, uint32_t val2, uint32_t va
   (x and y) xor (not x and z)
 
   Used in:
-  - SHA1, SHA256
+  - SHA0, SHA1, SHA224, SHA256
 */
-void choice(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = (val1 & val2) ^ ( (~val1) & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t choice(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return (val1 & val2) ^ ((~val1) & val3);
 }
 
 /*
@@ -175,15 +189,8 @@ void choice(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
   Used in:
   - SHA384, SHA512, SHA512/224, SHA512/256
 */
-void choice64(bool word[64], uint64_t val1, uint64_t val2, uint64_t val3) {
-  uint64_t result = (val1 & val2) ^ ( (~val1) & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 63; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint64_t choice64(uint64_t val1, uint64_t val2, uint64_t val3) {
+  return (val1 & val2) ^ ((~val1) & val3);
 }
 
 /*
@@ -193,17 +200,10 @@ void choice64(bool word[64], uint64_t val1, uint64_t val2, uint64_t val3) {
   (x and y) or (x and z) or (y and z)
 
   Used in:
-  - MD4, SHA0
+  - MD4
 */
-void oldMajority(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = (val1 & val2) | (val1 & val3) | (val2 & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t oldMajority(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return (val1 & val2) | (val1 & val3) | (val2 & val3);
 }
 
 /*
@@ -213,17 +213,10 @@ void oldMajority(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
   (x and y) xor (x and z) xor (y and z)
 
   Used in:
-  - SHA1, SHA256
+  - SHA0, SHA1, SHA224, SHA256
 */
-void majority(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = (val1 & val2) ^ (val1 & val3) ^ (val2 & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t majority(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return (val1 & val2) ^ (val1 & val3) ^ (val2 & val3);
 }
 
 /*
@@ -235,15 +228,8 @@ void majority(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
   Used in:
   - SHA384, SHA512, SHA512/224, SHA512/256
 */
-void majority64(bool word[64], uint64_t val1, uint64_t val2, uint64_t val3) {
-  uint64_t result = (val1 & val2) ^ (val1 & val3) ^ (val2 & val3);
-
-  short wordPos = 0;
-  for(int bitPos = 63; bitPos >= 0; --bitPos) {
-    bool bit = result & (1ull << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint64_t majority64(uint64_t val1, uint64_t val2, uint64_t val3) {
+  return (val1 & val2) ^ (val1 & val3) ^ (val2 & val3);
 }
 
 /*
@@ -255,3062 +241,3322 @@ void majority64(bool word[64], uint64_t val1, uint64_t val2, uint64_t val3) {
   Used in:
   - MD4, MD5, SHA0, SHA1
 */
-void parity(bool word[32], uint32_t val1, uint32_t val2, uint32_t val3) {
-  uint32_t result = val1 ^ val2 ^ val3;
-
-  short wordPos = 0;
-  for(int bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = result & (1l << bitPos);
-
-    word[wordPos++] = bit;
-  }
+inline uint32_t parity(uint32_t val1, uint32_t val2, uint32_t val3) {
+  return val1 ^ val2 ^ val3;
 }
 
 /*
-  Used by the following hash algorithms
+  Reads a 32 bit word stored in little endian byte order straight out of a
+  message block
 
-  - MD2, MD4, MD5
+  Used in:
+  - MD4, MD5
 */
-string hexDigest(uint8_t registers[], short size) {
-  string hashDigest = "";
-
-  short bitCount = 3;
-  unsigned short val = 0;
-  for(short registerNum = 0; registerNum < size; ++registerNum) {
-    uint8_t word = registers[registerNum];
-
-    for(short bits = 7; bits >= 0; --bits) {
-      bool bit = word & (1 << bits);
-
-      if(bit)
-        val += 1 << bitCount;
-
-      --bitCount;
-      if (bitCount == -1) {
-        switch (val) {
-          case 0:
-          case 1:
-          case 2:
-          case 3:
-          case 4:
-          case 5:
-          case 6:
-          case 7:
-          case 8:
-          case 9:
-            char num[1 + sizeof(char)];
-            sprintf(num, "%d", val);
-
-            hashDigest.append(num);
-            break;
-
-          case 10:
-            hashDigest.append("a");
-            break;
-
-          case 11:
-            hashDigest.append("b");
-            break;
-
-          case 12:
-            hashDigest.append("c");
-            break;
-
-          case 13:
-            hashDigest.append("d");
-            break;
-
-          case 14:
-            hashDigest.append("e");
-            break;
-
-          case 15:
-            hashDigest.append("f");
-        }
+inline uint32_t loadLittleEndian32(const uint8_t bytes[]) {
+  uint32_t word;
+  memcpy(&word, bytes, sizeof(word));
 
-        val = 0;
-        bitCount = 3;
-      }
-    }
-  }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
 
-  return hashDigest;
+  return word;
 }
 
 /*
-  Used by the following hash algorithms
+  Reads a 32 bit word stored in big endian byte order straight out of a
+  message block
 
+  Used in:
   - SHA0, SHA1, SHA224, SHA256
 */
-string hexDigest(uint32_t registers[], short size) {
-  string hashDigest = "";
-
-  short bitCount = 3;
-  unsigned short val = 0;
-  for(short registerNum = 0; registerNum < size; ++registerNum) {
-    uint32_t word = registers[registerNum];
-
-    for(short bits = 31; bits >= 0; --bits) {
-      bool bit = word & (1ull << bits);
-
-      if(bit)
-        val += 1 << bitCount;
-
-      --bitCount;
-      if (bitCount == -1) {
-        switch (val) {
-          case 0:
-          case 1:
-          case 2:
-          case 3:
-          case 4:
-          case 5:
-          case 6:
-          case 7:
-          case 8:
-          case 9:
-            char num[1 + sizeof(char)];
-            sprintf(num, "%d", val);
-
-            hashDigest.append(num);
-            break;
-
-          case 10:
-            hashDigest.append("a");
-            break;
-
-          case 11:
-            hashDigest.append("b");
-            break;
-
-          case 12:
-            hashDigest.append("c");
-            break;
-
-          case 13:
-            hashDigest.append("d");
-            break;
-
-          case 14:
-            hashDigest.append("e");
-            break;
-
-          case 15:
-            hashDigest.append("f");
-        }
+inline uint32_t loadBigEndian32(const uint8_t bytes[]) {
+  uint32_t word;
+  memcpy(&word, bytes, sizeof(word));
 
-        val = 0;
-        bitCount = 3;
-      }
-    }
-  }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
 
-  return hashDigest;
+  return word;
 }
 
 /*
-  Used by the following hash algorithms
+  Reads a 64 bit word stored in big endian byte order straight out of a
+  message block
 
+  Used in:
   - SHA384, SHA512, SHA512/224, SHA512/256
 */
-string hexDigest(uint64_t registers[], short size) {
-  string hashDigest = "";
-
-  short bitCount = 3;
-  unsigned short val = 0;
-  for(short registerNum = 0; registerNum < size; ++registerNum) {
-    uint64_t word = registers[registerNum];
-
-    for(short bits = 63; bits >= 0; --bits) {
-      bool bit = word & (1ull << bits);
-
-      if(bit)
-        val += 1 << bitCount;
-
-      --bitCount;
-      if (bitCount == -1) {
-        switch (val) {
-          case 0:
-          case 1:
-          case 2:
-          case 3:
-          case 4:
-          case 5:
-          case 6:
-          case 7:
-          case 8:
-          case 9:
-            char num[1 + sizeof(char)];
-            sprintf(num, "%d", val);
-
-            hashDigest.append(num);
-            break;
-
-          case 10:
-            hashDigest.append("a");
-            break;
-
-          case 11:
-            hashDigest.append("b");
-            break;
-
-          case 12:
-            hashDigest.append("c");
-            break;
-
-          case 13:
-            hashDigest.append("d");
-            break;
-
-          case 14:
-            hashDigest.append("e");
-            break;
-
-          case 15:
-            hashDigest.append("f");
-        }
+inline uint64_t loadBigEndian64(const uint8_t bytes[]) {
+  uint64_t word;
+  memcpy(&word, bytes, sizeof(word));
 
-        val = 0;
-        bitCount = 3;
-      }
-    }
-  }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
 
-  return hashDigest;
+  return word;
 }
 
-/*---------------------------------------------------------------------------*/
-/*                             Begin MD2 Section                             */
-/*---------------------------------------------------------------------------*/
-
 /*
-  MD2 Algorithm designed using the specifications described in
-
-  RFC 1319
+  Write a word into a digest in the given byte order
 
-  Published in April 1992
+  Used in:
+  - MD4, MD5, SHA0, SHA1, SHA224, SHA256
 */
+inline void storeLittleEndian32(uint8_t bytes[], uint32_t word) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
 
+  memcpy(bytes, &word, sizeof(word));
+}
 
-// Create substitution table (S table) for calculating the checksum and hash
-// digest
-const short subTable[256] = {41, 46, 67, 201, 162, 216, 124, 1, 61, 54, 84, 161,
-                             236, 240, 6, 19, 98, 167, 5, 243, 192, 199, 115, 140,
-                             152, 147, 43, 217, 188, 76, 130, 202, 30, 155, 87, 60,
-                             253, 212, 224, 22, 103, 66, 111, 24, 138, 23, 229, 18,
-                             190, 78, 196, 214, 218, 158, 222, 73, 160, 251, 245,
-                             142, 187, 47, 238, 122, 169, 104, 121, 145, 21, 178, 7,
-                             63, 148, 194, 16, 137, 11, 34, 95, 33, 128, 127, 93,
-                             154, 90, 144, 50, 39, 53, 62, 204, 231, 191, 247, 151,
-                             3, 255, 25, 48, 179, 72, 165, 181, 209, 215, 94, 146,
-                             42, 172, 86, 170, 198, 79, 184, 56, 210, 150, 164, 125,
-                             182, 118, 252, 107, 226, 156, 116, 4, 241, 69, 157,
-                             112, 89, 100, 113, 135, 32, 134, 91, 207, 101, 230, 45,
-                             168, 2, 27, 96, 37, 173, 174, 176, 185, 246, 28, 70,
-                             97, 105, 52, 64, 126, 15, 85, 71, 163, 35, 221, 81,
-                             175, 58, 195, 92, 249, 206, 186, 197, 234, 38, 44, 83,
-                             13, 110, 133, 40, 132, 9, 211, 223, 205, 244, 65, 129,
-                             77, 82, 106, 220, 55, 200, 108, 193, 171, 250, 36,
-                             225, 123, 8, 12, 189, 177, 74, 120, 136, 149, 139,
-                             227, 99, 232, 109, 233, 203, 213, 254, 59, 0, 29, 57,
-                             242, 239, 183, 14, 102, 88, 208, 228, 166, 119, 114,
-                             248, 235, 117, 75, 10, 49, 68, 80, 180, 143, 237, 31,
-                             26, 219, 153, 141, 51, 159, 17, 131, 20};
-
-
-string md2(string data) {
-  uint8_t hashBlock[16]; // Holds resulting hash
-
-  /* Generate pad */
-
-  // MD2 pads are multiples of 16 bytes (128 bits)
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (128 * (padLength / 128 + 1));
-
-  // Padding is still performed even if the original message length is a multiple
-  // of 16 bytes
-
-  // Add space for the checksum that is appended after padding
-  padLength += 128;
-
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
-
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
-
-  // Fill the start of the pad buffer with the bits in the data passed to be
-  // hashed
-  long padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
-
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos++] = dataVal & (1l << bitPos);
-    }
-  }
+inline void storeBigEndian32(uint8_t bytes[], uint32_t word) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
 
-  // Add padding
-  uint8_t padValue = 16 - (data.length() % 16);
+  memcpy(bytes, &word, sizeof(word));
+}
 
-  while(padPos < padLength - 128) {
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos++] = padValue & (1l << bitPos);
-    }
-  }
+#if defined(__x86_64__) || defined(__i386__)
 
-  /* Calculate checksum */
+/*
+  Kernel tiers, each listing the instruction set extensions its kernels may
+  use. Setting the HASHES_CPU_TIER environment variable to one of these names
+  limits the kernels picked at startup to that tier, so that they can be
+  compared on the same host. An extension still has to be detected for its
+  kernels to run, and an unknown name is ignored.
+*/
+struct CpuTier {
+  const char *name;
+  bool ssse3;
+  bool avx2;
+  bool avx512;
+  bool shaExtensions;
+};
+
+const CpuTier cpuTiers[] = {
+  {"portable", false, false, false, false},
+  {"ssse3", true, false, false, false},
+  {"avx2", true, true, false, false},
+  {"avx512", true, true, true, false},
+  {"shani", true, false, false, true},
+};
 
-  bool checkSum[128];
-  uint8_t l = 0;
+/*
+  Returns the tier named by HASHES_CPU_TIER, or the one allowing everything
+  if it isn't set. An unknown name also allows everything, after a warning
+  on stderr so a mistyped override isn't mistaken for a working one.
+*/
+CpuTier readCpuTier() {
+  const CpuTier unrestricted = {"native", true, true, true, true};
+  const char *name = getenv("HASHES_CPU_TIER");
 
-  // Zero out checksum array
-  for(short checkPos = 127; checkPos >= 0; --checkPos)
-    checkSum[checkPos] = 0;
+  if(name == nullptr)
+    return unrestricted;
 
-  long blocks = ceil(padLength / 128.0) - 1;
-  uint8_t byte = 0;
-  short checkPos = 0;
-  int msgPos = 0;
-  short bitCount = 7;
-  for(long block = 0; block < blocks; ++block) {
-    for(short msgCount = 0; msgCount < 128; ++msgCount) {
-      if(padBuffer[msgPos++])
-        byte += 1 << bitCount;
-      --bitCount;
+  for(const CpuTier &tier : cpuTiers)
+    if(strcmp(name, tier.name) == 0)
+      return tier;
 
-      if(bitCount == -1) {
-        uint8_t checkVal = 0;
-        for(short count = 7; count >= 0; --count)
-          if(checkSum[checkPos++])
-            checkVal += 1 << count;
+  cerr << "hashes: ignoring unknown HASHES_CPU_TIER \"" << name << "\", expected one of";
+  for(const CpuTier &tier : cpuTiers)
+    cerr << ' ' << tier.name;
+  cerr << endl;
 
-        checkPos -= 8;
+  return unrestricted;
+}
 
-        l = subTable[byte ^ l] ^ checkVal;
-        for(short count = 7; count >= 0; --count)
-          checkSum[checkPos++] = l & (1 << count);
+const CpuTier cpuTier = readCpuTier();
 
-        bitCount = 7;
-        byte = 0;
-      }
-    }
-    checkPos = 0;
-  }
+/*
+  Checks CPUID for the SHA extensions, along with SSE4.1 which the kernels
+  using them need for shuffling the state in and out. Detected once at
+  startup; anything hashed before then simply takes the portable path.
 
-  checkPos = 0;
+  Used in:
+  - SHA1, SHA224, SHA256
+*/
+bool detectShaExtensions() {
+  unsigned int eax, ebx, ecx, edx;
 
-  // Append checksum to pad buffer
-  while(padPos < padLength)
-    padBuffer[padPos++] = checkSum[checkPos++];
+  if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1))
+    return false;
 
-  /* Process pad buffer in 16 byte (128 bit) blocks */
+  if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    return false;
 
-  bool messageDigest[384];
+  return ebx & bit_SHA;
+}
 
-  // Zero out message digest
-  for(short count = 384; count >= 0; --count)
-    messageDigest[count] = 0;
+const bool cpuHasShaExtensions = cpuTier.shaExtensions && detectShaExtensions();
 
-  // Process every 128 bit block
-  bitCount = 7;
-  uint8_t temp1 = 0;
-  uint8_t temp2 = 0;
-  for(long block = 0; block <= blocks; ++block) {
-    // Copy current block into message digest
-    for(short blockBit = 0; blockBit < 128; ++blockBit) {
-      bool bit = padBuffer[block * 128 + blockBit];
-      messageDigest[128 + blockBit] = bit;
+/*
+  Checks for AVX2 along with the operating system support for saving the
+  wider registers
 
-      if(bit)
-        temp1 += 1l << bitCount;
+  Used in:
+  - MD2, MD4, MD5, SHA1, SHA224, SHA256, SHA384, SHA512, SHA512/224, SHA512/256,
+    hex encoding and decoding
+*/
+bool detectAVX2() {
+  __builtin_cpu_init();
 
-      if(messageDigest[blockBit])
-        temp2 += 1l << bitCount;
+  return __builtin_cpu_supports("avx2");
+}
 
-      --bitCount;
+const bool cpuHasAVX2 = cpuTier.avx2 && detectAVX2();
 
-      if(bitCount == -1) {
-        uint8_t temp3 = temp1 ^ temp2;
+/*
+  Used in:
+  - SHA0, SHA1, hex encoding and decoding
+*/
+bool detectSSSE3() {
+  __builtin_cpu_init();
 
-        for(short pos = 7; pos >= 0; --pos) {
-          bool bit = temp3 & (1l << pos);
-          messageDigest[256 + (blockBit - pos)] = bit;
-        }
+  return __builtin_cpu_supports("ssse3");
+}
 
-        bitCount = 7;
-        temp1 = 0;
-        temp2 = 0;
-      }
-    }
+const bool cpuHasSSSE3 = cpuTier.ssse3 && detectSSSE3();
 
-    uint8_t t = 0;
+/*
+  Checks for the AVX-512 foundation and byte/word instructions
 
-    // Process 18 rounds of compression
-    bitCount = 7;
-    uint8_t digestByte = 0;
-    for(short round = 0; round < 18; ++round) {
-      // Run round
-      for(short processBit = 0; processBit < 384; ++processBit) {
-        if(messageDigest[processBit])
-          digestByte += 1l << bitCount;
-        --bitCount;
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
+*/
+bool detectAVX512() {
+  __builtin_cpu_init();
 
-        if(bitCount == -1) {
-          uint8_t temp = digestByte ^ subTable[t];
+  return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
 
-          // Set t and the current byte in the digest to the temp value
-          // generated
+const bool cpuHasAVX512 = cpuTier.avx512 && detectAVX512();
 
-          t = temp;
+#endif
 
-          bitCount = 7;
-          uint8_t test = 0;
-          for(short messagePnt = processBit - 7; messagePnt <= processBit; ++messagePnt) {
-            bool bit = temp & (1l << bitCount);
-            if(bit)
-              test += 1l << bitCount;
+/*
+  Table holding the two hex characters of every byte value, and the reverse
+  table holding the value of every hex character (or -1 for characters that
+  aren't hex digits), both generated at compile time
+*/
+struct HexTable {
+  char pairs[256][2];
+  int8_t values[256];
+};
+
+constexpr HexTable generateHexTable() {
+  HexTable table = {};
+
+  const char digits[] = "0123456789abcdef";
+  for(int val = 0; val < 256; ++val) {
+    table.pairs[val][0] = digits[val >> 4];
+    table.pairs[val][1] = digits[val & 15];
+    table.values[val] = -1;
+  }
 
-            messageDigest[messagePnt] = temp & (1l << bitCount);
-            --bitCount;
-          }
+  for(int val = 0; val < 16; ++val) {
+    table.values[(uint8_t)digits[val]] = val;
+    table.values[(uint8_t)"0123456789ABCDEF"[val]] = val;
+  }
 
-          bitCount = 7;
-          digestByte = 0;
-        }
-      }
+  return table;
+}
 
-      // set t to (t + round) % 256
-      t = ((int)t + round) % 256;
-    }
-  }
+constexpr HexTable hexTable = generateHexTable();
 
-  // Create state register array for the resulting 16 bytes from the start
-  // of the message digest to create hex digest output
-  bitCount = 7;
-  byte = 0;
-  short hashPos = 0;
-  for(short bit = 0; bit < 128; ++bit) {
-    if(messageDigest[bit])
-      byte += 1l << bitCount;
-    --bitCount;
-
-    if(bitCount == -1) {
-      hashBlock[hashPos] = byte;
-      ++hashPos;
-
-      byte = 0;
-      bitCount = 7;
-    }
+void hexEncodeScalar(const uint8_t bytes[], size_t length, char output[]) {
+  for(size_t pos = 0; pos < length; ++pos)
+    memcpy(output + pos * 2, hexTable.pairs[bytes[pos]], 2);
+}
+
+bool hexDecodeScalar(const char hex[], size_t length, uint8_t bytes[]) {
+  for(size_t pos = 0; pos < length; pos += 2) {
+    int8_t high = hexTable.values[(uint8_t)hex[pos]];
+    int8_t low = hexTable.values[(uint8_t)hex[pos + 1]];
+
+    if(high < 0 || low < 0)
+      return false;
+
+    bytes[pos / 2] = (high << 4) | low;
   }
 
-  return hexDigest(hashBlock, 16);
+  return true;
 }
 
-/*---------------------------------------------------------------------------*/
-/*                             Begin MD4 Section                             */
-/*---------------------------------------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
 
 /*
-  MD4 Algorithm designed using the specifications described in
+  Vectorized hex encoding and decoding
 
-  RFC 1320
+  Encoding splits every byte into its two nibbles and uses them as indices
+  into a 16 entry character table with a byte shuffle, then interleaves the
+  high and low characters. Decoding folds letters to lower case, validates
+  every character with range compares, converts them to nibble values and
+  merges each pair into a byte with a multiply-add.
 
-  Published in April 1992
+  The SSSE3 kernels handle 16 bytes (32 characters) and the AVX2 kernels 32
+  bytes (64 characters) per iteration. Whatever is left is handled by the
+  scalar versions above.
 */
+__attribute__((target("ssse3")))
+size_t hexEncodeSSSE3(const uint8_t bytes[], size_t length, char output[]) {
+  const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i nibbleMask = _mm_set1_epi8(15);
+
+  size_t pos = 0;
+  for(; pos + 16 <= length; pos += 16) {
+    __m128i input = _mm_loadu_si128((const __m128i *)(bytes + pos));
 
-// Translates 32 or 64 bit binary word into numerical representation
-unsigned long translateWord(bool word[], unsigned int size) {
-  unsigned long temp = 0;
+    __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+    __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(input, nibbleMask));
 
-  short bitTrack = 0;
-  for(short wordTrack = (size - 1); wordTrack >= 0; --wordTrack) {
-    if(word[wordTrack])
-      temp += 1l << bitTrack;
-    ++bitTrack;
+    _mm_storeu_si128((__m128i *)(output + pos * 2), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128((__m128i *)(output + pos * 2 + 16), _mm_unpackhi_epi8(high, low));
   }
 
-  return temp;
+  return pos;
 }
 
-void md4processBlock(bool block[512], uint32_t stateRegisters[4]) {
-  // Translate block into an array of 16 32 bit words, taking each 32 bit
-  // value's bytes and rearranging them into little endian convention
-  uint32_t wordArray[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+__attribute__((target("avx2")))
+size_t hexEncodeAVX2(const uint8_t bytes[], size_t length, char output[]) {
+  const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                          '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                          '0', '1', '2', '3', '4', '5', '6', '7',
+                                          '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m256i nibbleMask = _mm256_set1_epi8(15);
 
-  short wordTrack = 0;
-  short bitTrack = 31;
-  uint32_t temp = 0;
-  for(int blockTrack = 0; blockTrack < 512; ++blockTrack) {
-    if(block[blockTrack])
-      temp += 1l << bitTrack;
-    --bitTrack;
+  size_t pos = 0;
+  for(; pos + 32 <= length; pos += 32) {
+    __m256i input = _mm256_loadu_si256((const __m256i *)(bytes + pos));
 
-    if(bitTrack == -1) {
-      temp = __builtin_bswap32(temp);
-      wordArray[wordTrack++] = temp;
-      temp = 0;
-      bitTrack = 31;
-    }
+    __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+    __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(input, nibbleMask));
+
+    // Interleaving works within each 128 bit lane, so the lanes have to be
+    // put back in order before storing
+    __m256i first = _mm256_unpacklo_epi8(high, low);
+    __m256i second = _mm256_unpackhi_epi8(high, low);
+
+    _mm256_storeu_si256((__m256i *)(output + pos * 2), _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256((__m256i *)(output + pos * 2 + 32), _mm256_permute2x128_si256(first, second, 0x31));
   }
 
-  // Used to contain values that have been processed
-  unsigned long workingVal = 0;
-  bool workingWord[32];
+  return pos;
+}
 
-  /* Round 1 Operations Start */
+/*
+  Converts 16 hex characters into their nibble values, setting valid to false
+  if any of them isn't a hex digit
+*/
+__attribute__((target("ssse3")))
+inline __m128i hexValuesSSSE3(__m128i chars, bool &valid) {
+  __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
 
-  // A = rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[0]) % 4294967296, 3)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[0];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[1]) % 4294967296, 7)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[1];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[2]) % 4294967296, 11)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[2];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[3]) % 4294967296, 19)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[3];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 19);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[4]) % 4294967296, 3)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[4];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[5]) % 4294967296, 7)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[5];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[6]) % 4294967296, 11)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[6];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[7]) % 4294967296, 19)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[7];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 19);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[8]) % 4294967296, 3)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[8];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[9]) % 4294967296, 7)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[9];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[10]) % 4294967296, 11)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[10];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[11]) % 4294967296, 19)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[11];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 19);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[12]) % 4294967296, 3)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[12];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[13]) % 4294967296, 7)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[13];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[14]) % 4294967296, 11)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[14];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[15]) % 4294967296, 19)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[15];
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 19);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
+  __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+  __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                   _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
 
-  /* Round 1 Operations Finish */
+  if(_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff)
+    valid = false;
 
-  /* Round 2 Operations Start */
+  __m128i digitValues = _mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+  __m128i letterValues = _mm_and_si128(isLetter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+
+  return _mm_or_si128(digitValues, letterValues);
+}
 
-  // A = rotationalLeftShift((A + oldMajority(B, C, D) + blockWord[0] + 1518500249) % 4294967296, 3)
-  oldMajority(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[0] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldMajority(A, B, C) + blockWord[4] + 1518500249) % 4294967296, 5)
-  oldMajority(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[4] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldMajority(D, A, B) + blockWord[8] + 1518500249) % 4294967296, 9)
-  oldMajority(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[8] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldMajority(C, D, A) + blockWord[12] + 1518500249) % 4294967296, 13)
-  oldMajority(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[12] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 13);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldMajority(B, C, D) + blockWord[1] + 1518500249) % 4294967296, 3)
-  oldMajority(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[1] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldMajority(A, B, C) + blockWord[5] + 1518500249) % 4294967296, 5)
-  oldMajority(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[5] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldMajority(D, A, B) + blockWord[9] + 1518500249) % 4294967296, 9)
-  oldMajority(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[9] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldMajority(C, D, A) + blockWord[13] + 1518500249) % 4294967296, 13)
-  oldMajority(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[13] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 13);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldMajority(B, C, D) + blockWord[2] + 1518500249) % 4294967296, 3)
-  oldMajority(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[2] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldMajority(A, B, C) + blockWord[6] + 1518500249) % 4294967296, 5)
-  oldMajority(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[6] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldMajority(D, A, B) + blockWord[10] + 1518500249) % 4294967296, 9)
-  oldMajority(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[10] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldMajority(C, D, A) + blockWord[14] + 1518500249) % 4294967296, 13)
-  oldMajority(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[14] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 13);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + oldMajority(B, C, D) + blockWord[3] + 1518500249) % 4294967296, 3)
-  oldMajority(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[3] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + oldMajority(A, B, C) + blockWord[7] + 1518500249) % 4294967296, 5)
-  oldMajority(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[7] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + oldMajority(D, A, B) + blockWord[11] + 1518500249) % 4294967296, 9)
-  oldMajority(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[11] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + oldMajority(C, D, A) + blockWord[15] + 1518500249) % 4294967296, 13)
-  oldMajority(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[15] + 1518500249;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 13);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
+__attribute__((target("ssse3")))
+size_t hexDecodeSSSE3(const char hex[], size_t length, uint8_t bytes[], bool &valid) {
+  // Multiplies the first nibble of each pair by 16 and adds the second
+  const __m128i merge = _mm_set1_epi16(0x0110);
 
-  /* Round 2 Operations Finish */
+  size_t pos = 0;
+  for(; pos + 32 <= length; pos += 32) {
+    __m128i first = hexValuesSSSE3(_mm_loadu_si128((const __m128i *)(hex + pos)), valid);
+    __m128i second = hexValuesSSSE3(_mm_loadu_si128((const __m128i *)(hex + pos + 16)), valid);
 
-  /* Round 3 Operatins Start */
-
-  // A = rotationalLeftShift((A + parity(B, C, D) + blockWord[0] + 1859775393) % 4294967296, 3)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[0] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + parity(A, B, C) + blockWord[8] + 1859775393) % 4294967296, 9)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[8] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + parity(D, A, B) + blockWord[4] + 1859775393) % 4294967296, 11)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[4] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + parity(C, D, A) + blockWord[12] + 1859775393) % 4294967296, 15)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[12] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + parity(B, C, D) + blockWord[2] + 1859775393) % 4294967296, 3)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[2] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + parity(A, B, C) + blockWord[10] + 1859775393) % 4294967296, 9)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[10] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + parity(D, A, B) + blockWord[6] + 1859775393) % 4294967296, 11)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[6] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + parity(C, D, A) + blockWord[14] + 1859775393) % 4294967296, 15)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[14] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + parity(B, C, D) + blockWord[1] + 1859775393) % 4294967296, 3)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[1] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + parity(A, B, C) + blockWord[9] + 1859775393) % 4294967296, 9)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[9] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + parity(D, A, B) + blockWord[5] + 1859775393) % 4294967296, 11)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[5] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + parity(C, D, A) + blockWord[13] + 1859775393) % 4294967296, 15)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[13] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = rotationalLeftShift((A + parity(B, C, D) + blockWord[3] + 1859775393) % 4294967296, 3)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[3] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 3);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = rotationalLeftShift((D + parity(A, B, C) + blockWord[11] + 1859775393) % 4294967296, 9)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[11] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = rotationalLeftShift((C + parity(D, A, B) + blockWord[7] + 1859775393) % 4294967296, 11)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[7] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = rotationalLeftShift((B + parity(C, D, A) + blockWord[15] + 1859775393) % 4294967296, 15)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[15] + 1859775393;
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = translateWord(workingWord, 32);
-  stateRegisters[1] = (uint32_t)workingVal;
+    if(!valid)
+      return pos;
 
-  /* Round 3 Operations Finish */
+    __m128i merged = _mm_packus_epi16(_mm_maddubs_epi16(first, merge), _mm_maddubs_epi16(second, merge));
+    _mm_storeu_si128((__m128i *)(bytes + pos / 2), merged);
+  }
 
+  return pos;
 }
 
-string md4(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-                                          // of the pad buffer
+__attribute__((target("avx2")))
+inline __m256i hexValuesAVX2(__m256i chars, bool &valid) {
+  __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
+  __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+  __m256i isLetter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                      _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
 
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
+  if(_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1)
+    valid = false;
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+  __m256i digitValues = _mm256_and_si256(isDigit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+  __m256i letterValues = _mm256_and_si256(isLetter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
 
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  return _mm256_or_si256(digitValues, letterValues);
+}
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+__attribute__((target("avx2")))
+size_t hexDecodeAVX2(const char hex[], size_t length, uint8_t bytes[], bool &valid) {
+  const __m256i merge = _mm256_set1_epi16(0x0110);
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  size_t pos = 0;
+  for(; pos + 64 <= length; pos += 64) {
+    __m256i first = hexValuesAVX2(_mm256_loadu_si256((const __m256i *)(hex + pos)), valid);
+    __m256i second = hexValuesAVX2(_mm256_loadu_si256((const __m256i *)(hex + pos + 32)), valid);
+
+    if(!valid)
+      return pos;
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+    // Packing works within each 128 bit lane, so the 64 bit quarters have to
+    // be put back in order before storing
+    __m256i merged = _mm256_packus_epi16(_mm256_maddubs_epi16(first, merge), _mm256_maddubs_epi16(second, merge));
+    _mm256_storeu_si256((__m256i *)(bytes + pos / 2), _mm256_permute4x64_epi64(merged, 0xd8));
+  }
 
-  padPos = padLength - 64;
+  return pos;
+}
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+#endif
 
-  // Create a byte array using the individual bytes of the saved message length
-  // before padding, using little endian convention
-  uint64_t val = lengthHolder;
+void hexEncode(const uint8_t bytes[], size_t length, char output[]) {
+  size_t pos = 0;
 
-  uint8_t byteArray[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2)
+    pos = hexEncodeAVX2(bytes, length, output);
 
-  for(short byte = 0; byte < 8; ++byte)
-    switch(byte) {
-      case 0:
-        byteArray[byte] = (lengthHolder >> 0) & 255;
-        break;
+  if(cpuHasSSSE3)
+    pos += hexEncodeSSSE3(bytes + pos, length - pos, output + pos * 2);
+#endif
 
-      case 1:
-        byteArray[byte] = (lengthHolder >> 8) & 255;
-        break;
+  hexEncodeScalar(bytes + pos, length - pos, output + pos * 2);
+}
 
-      case 2:
-        byteArray[byte] = (lengthHolder >> 16) & 255;
-        break;
+void hexEncodeDigests(const uint8_t digests[], size_t digestLength, size_t count, char output[],
+                      size_t outputStride) {
+  // Digests written back to back form one contiguous run of hex
+  if(outputStride == digestLength * 2) {
+    hexEncode(digests, digestLength * count, output);
+    return;
+  }
 
-      case 3:
-        byteArray[byte] = (lengthHolder >> 24) & 255;
-        break;
+  for(size_t digest = 0; digest < count; ++digest)
+    hexEncode(digests + digest * digestLength, digestLength, output + digest * outputStride);
+}
 
-      case 4:
-        byteArray[byte] = (lengthHolder >> 32) & 255;
-        break;
+bool hexDecode(const char hex[], size_t length, uint8_t bytes[]) {
+  if(length % 2 != 0)
+    return false;
 
-      case 5:
-        byteArray[byte] = (lengthHolder >> 40) & 255;
-        break;
+  size_t pos = 0;
+  bool valid = true;
 
-      case 6:
-        byteArray[byte] = (lengthHolder >> 48) & 255;
-        break;
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2)
+    pos = hexDecodeAVX2(hex, length, bytes, valid);
 
-      case 7:
-        byteArray[byte] = (lengthHolder >> 56) & 255;
-    }
+  if(cpuHasSSSE3 && valid)
+    pos += hexDecodeSSSE3(hex + pos, length - pos, bytes + pos / 2, valid);
 
-  // Append byte array into the remaining space of the pad buffer as individual
-  // bits
-  for(uint8_t val: byteArray)
-    for(short bitPos = 7; bitPos >= 0; --bitPos) {
-      bool bit = val & (1l << bitPos);
+  if(!valid)
+    return false;
+#endif
 
-      padBuffer[padPos++] = bit;
-    }
+  return hexDecodeScalar(hex + pos, length - pos, bytes + pos / 2);
+}
 
-  // Create and fill initial state registers
-  uint32_t registers[4];
+/*
+  Used by every hash algorithm to turn its binary digest into the string
+  returned by the hex interface
+*/
+string hexDigest(const uint8_t bytes[], size_t length) {
+  string hashDigest(length * 2, '0');
+  hexEncode(bytes, length, &hashDigest[0]);
 
-  for(short count = 0; count < 4; ++count)
-    switch(count) {
-      case 0:
-        registers[count] = 1732584193;  // 0x67452301
-        break;
+  return hashDigest;
+}
 
-      case 1:
-        registers[count] = 4023233417;  // 0xefcdab89
-        break;
+/*
+  Lane counts for the batch functions of each algorithm, by the average
+  length of the messages in a batch: up to 64 bytes, up to 1 KiB and longer.
+  They are only set by calibrateKernels(), and a count of 0 leaves each batch
+  function to its usual choice of the widest kernel the CPU has.
+*/
+enum BatchAlgorithm { batchMd2, batchMd4, batchMd5, batchSha1, batchSha256, batchSha512, batchAlgorithms };
 
-      case 2:
-        registers[count] = 2562383102;  // 0x98badcfe
-        break;
+const short batchSizeBuckets = 3;
 
-      case 3:
-        registers[count] = 271733878;   // 0x10325476
-    }
+short batchLanes[batchAlgorithms][batchSizeBuckets] = {};
 
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
+short batchSizeBucket(size_t averageLength) {
+  if(averageLength <= 64)
+    return 0;
 
-  int blockTrack = 0;
-  uint32_t registerStateSave[4];
+  return averageLength <= 1024 ? 1 : 2;
+}
 
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
+/*
+  Used in:
+  - MD2, MD4, MD5, SHA1, SHA224, SHA256, SHA384, SHA512, SHA512/224, SHA512/256
+*/
+short calibratedBatchLanes(BatchAlgorithm algorithm, const string_view data[], size_t count) {
+  size_t totalLength = 0;
+  for(size_t message = 0; message < count; ++message)
+    totalLength += data[message].length();
 
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for (uint32_t val: registers)
-        registerStateSave[pos++] = val;
+  return batchLanes[algorithm][batchSizeBucket(count == 0 ? 0 : totalLength / count)];
+}
 
-      md4processBlock(block, registers);
+/*
+  Drives a multi-buffer kernel over a batch of independent messages
 
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 4; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(registers[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
+  Each of the lanes works through one message at a time. Whole blocks are
+  read straight out of the message, and the padded final one or two blocks
+  are built in a small per-lane buffer using the algorithm's length field
+  size and byte order. When a lane finishes its message, store receives the
+  lane's registers along with the message index, and the lane is refilled
+  with the next waiting message. Once no messages are left, idle lanes are
+  fed a dummy block and their results discarded.
 
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+  kernel(blocks, state) must process blocks[lane] for every lane, with the
+  chaining registers held word-major in state[word][lane] so that each word
+  of every lane can be loaded into a single vector register.
 
-        uint32_t newStateVal = tempVal % 4294967296;
+  Used in:
+  - MD4, MD5, SHA1, SHA224, SHA256, SHA384, SHA512, SHA512/224, SHA512/256
+*/
+template<typename Word, size_t lanes, size_t stateWords, size_t blockSize, size_t lengthBytes,
+         bool bigEndianLength, typename Kernel, typename Store>
+void hashBatch(const string_view data[], size_t count, const Word startingState[], Kernel kernel, Store store) {
+  struct Lane {
+    bool active;
+    size_t message;
+    const uint8_t *data;
+    size_t wholeBlocks;
+    size_t totalBlocks;
+    size_t block;
+    uint8_t tail[2 * blockSize];
+  };
+
+  static const uint8_t idleBlock[blockSize] = {};
+
+  Lane lane[lanes];
+  alignas(64) Word state[stateWords][lanes];
+  const uint8_t *blocks[lanes];
+
+  size_t nextMessage = 0;
+  size_t activeLanes = 0;
+
+  // Loads the next waiting message into a lane, padding its final blocks
+  auto refill = [&](size_t pos) {
+    Lane &current = lane[pos];
+    current.active = nextMessage < count;
+
+    if(!current.active)
+      return;
+
+    string_view message = data[nextMessage];
+    size_t remainder = message.length() % blockSize;
+
+    current.message = nextMessage++;
+    current.data = (const uint8_t *)message.data();
+    current.wholeBlocks = message.length() / blockSize;
+    current.block = 0;
+
+    // Add a 1 bit followed by 0s, leaving room for the length at the end of
+    // the first or, if that doesn't fit, the second tail block
+    size_t tailLength = remainder + 1 + lengthBytes <= blockSize ? blockSize : 2 * blockSize;
+    current.totalBlocks = current.wholeBlocks + tailLength / blockSize;
+
+    memcpy(current.tail, current.data + current.wholeBlocks * blockSize, remainder);
+    current.tail[remainder] = 128;
+    memset(current.tail + remainder + 1, 0, tailLength - remainder - 1);
+
+    uint128_t lengthHolder = (uint128_t)message.length() * 8; // Message length in bits
+    for(size_t byte = 0; byte < lengthBytes; ++byte) {
+      size_t shift = 8 * (bigEndianLength ? lengthBytes - 1 - byte : byte);
+      current.tail[tailLength - lengthBytes + byte] = (lengthHolder >> shift) & 255;
+    }
 
-        registers[pointer] = newStateVal;
+    for(size_t word = 0; word < stateWords; ++word)
+      state[word][pos] = startingState[word];
 
-        tempVal = 0;
-      }
+    ++activeLanes;
+  };
 
-      blockTrack = 0;
-    }
-  }
+  for(size_t pos = 0; pos < lanes; ++pos)
+    refill(pos);
 
-  // Translate final register state values into an array of bytes, arranged in
-  // little endian convention
-  uint8_t digestArray[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  while(activeLanes > 0) {
+    for(size_t pos = 0; pos < lanes; ++pos) {
+      const Lane &current = lane[pos];
 
-  short byteTracker = 0;
-  for(uint32_t registerVal: registers) {
-    digestArray[byteTracker++] = (registerVal >> 0) & 255;
-    digestArray[byteTracker++] = (registerVal >> 8) & 255;
-    digestArray[byteTracker++] = (registerVal >> 16) & 255;
-    digestArray[byteTracker++] = (registerVal >> 24) & 255;
-  }
+      if(!current.active)
+        blocks[pos] = idleBlock;
+      else if(current.block < current.wholeBlocks)
+        blocks[pos] = current.data + current.block * blockSize;
+      else
+        blocks[pos] = current.tail + (current.block - current.wholeBlocks) * blockSize;
+    }
 
-  return hexDigest(digestArray, 16);
-}
+    kernel(blocks, state);
 
-/*---------------------------------------------------------------------------*/
-/*                             Begin MD5 Section                             */
-/*---------------------------------------------------------------------------*/
+    for(size_t pos = 0; pos < lanes; ++pos) {
+      Lane &current = lane[pos];
 
-/*
-  MD4 Algorithm designed using the specifications described in
+      if(!current.active || ++current.block < current.totalBlocks)
+        continue;
 
-  RFC 1321
+      Word registers[stateWords];
+      for(size_t word = 0; word < stateWords; ++word)
+        registers[word] = state[word][pos];
 
-  Published in April 1992
-*/
+      store(current.message, registers);
 
-void md5processBlock(bool block[512], uint32_t stateRegisters[4]) {
-  // Translate block into an array of 16 32 bit words, taking each 32 bit
-  // value's bytes and rearranging them into little endian convention
-  uint32_t wordArray[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-  short wordTrack = 0;
-  short bitTrack = 31;
-  uint32_t temp = 0;
-  for(int blockTrack = 0; blockTrack < 512; ++blockTrack) {
-    if(block[blockTrack])
-      temp += 1l << bitTrack;
-    --bitTrack;
-
-    if(bitTrack == -1) {
-      temp = __builtin_bswap32(temp);
-      wordArray[wordTrack++] = temp;
-      temp = 0;
-      bitTrack = 31;
+      --activeLanes;
+      refill(pos);
     }
   }
+}
 
-  // Used to contain values that have been processed
-  unsigned long workingVal = 0;
-  bool workingWord[32];
+#if defined(__x86_64__) || defined(__i386__)
 
-  short sineTrack = 1; // Tracks the value we pass to sine function
+/*
+  Transposes an 8x8 matrix of 32 bit words, turning 8 words from each of 8
+  lanes into the same word of every lane
 
-  /* Round 1 Operations Start */
+  Used in:
+  - MD4, MD5, SHA1, SHA224, SHA256
+*/
+__attribute__((target("avx2")))
+inline void transpose8x32(__m256i rows[8]) {
+  __m256i pairs[8], quads[8];
 
-  // A = B + rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[0] + abs(sin(1)) * 4294967296), 7)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[0] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[1] + abs(sin(2)) * 4294967296), 12)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[1] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 12);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[2] + abs(sin(3)) * 4294967296), 17)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[2] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 17);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[3] + abs(sin(4)) * 4294967296), 22)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[3] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 22);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[4] + abs(sin(5)) * 4294967296), 7)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[4] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[5] + abs(sin(6)) * 4294967296), 12)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[5] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 12);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[6] + abs(sin(7)) * 4294967296), 17)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[6] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 17);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[7] + abs(sin(8)) * 4294967296), 22)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[7] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 22);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[8] + abs(sin(9)) * 4294967296), 7)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[8] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[9] + abs(sin(10)) * 4294967296), 12)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[9] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 12);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[10] + abs(sin(11)) * 4294967296), 17)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[10] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 17);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[11] + abs(sin(12)) * 4294967296), 22)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[11] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 22);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + oldChoice(B, C, D) + blockWord[12] + abs(sin(13)) * 4294967296), 7)
-  oldChoice(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[12] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 7);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + oldChoice(A, B, C) + blockWord[13] + abs(sin(14)) * 4294967296), 12)
-  oldChoice(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[13] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 12);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + oldChoice(D, A, B) + blockWord[14] + abs(sin(15)) * 4294967296), 17)
-  oldChoice(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[14] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 17);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + oldChoice(C, D, A) + blockWord[15] + abs(sin(16)) * 4294967296), 22)
-  oldChoice(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[15] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 22);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
+  for(short row = 0; row < 8; row += 2) {
+    pairs[row] = _mm256_unpacklo_epi32(rows[row], rows[row + 1]);
+    pairs[row + 1] = _mm256_unpackhi_epi32(rows[row], rows[row + 1]);
+  }
 
-  /* Round 1 Operations Finish */
+  for(short row = 0; row < 8; row += 4) {
+    quads[row] = _mm256_unpacklo_epi64(pairs[row], pairs[row + 2]);
+    quads[row + 1] = _mm256_unpackhi_epi64(pairs[row], pairs[row + 2]);
+    quads[row + 2] = _mm256_unpacklo_epi64(pairs[row + 1], pairs[row + 3]);
+    quads[row + 3] = _mm256_unpackhi_epi64(pairs[row + 1], pairs[row + 3]);
+  }
 
-  /* Round 2 Operations Start */
+  for(short row = 0; row < 4; ++row) {
+    rows[row] = _mm256_permute2x128_si256(quads[row], quads[row + 4], 0x20);
+    rows[row + 4] = _mm256_permute2x128_si256(quads[row], quads[row + 4], 0x31);
+  }
+}
 
-  // A = B + rotationalLeftShift((A + choiceVariant(B, C, D) + blockWord[1] + abs(sin(17)) * 4294967296), 5)
-  choiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[1] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + choiceVariant(A, B, C) + blockWord[6] + abs(sin(18)) * 4294967296), 9)
-  choiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[6] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + choiceVariant(D, A, B) + blockWord[11] + abs(sin(19)) * 4294967296), 14)
-  choiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[11] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 14);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + choiceVariant(C, D, A) + blockWord[0] + abs(sin(20)) * 4294967296), 20)
-  choiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[0] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 20);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + choiceVariant(B, C, D) + blockWord[5] + abs(sin(21)) * 4294967296), 5)
-  choiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[5] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + choiceVariant(A, B, C) + blockWord[10] + abs(sin(22)) * 4294967296), 9)
-  choiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[10] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + choiceVariant(D, A, B) + blockWord[15] + abs(sin(23)) * 4294967296), 14)
-  choiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[15] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 14);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + choiceVariant(C, D, A) + blockWord[4] + abs(sin(24)) * 4294967296), 20)
-  choiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[4] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 20);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + choiceVariant(B, C, D) + blockWord[9] + abs(sin(25)) * 4294967296), 5)
-  choiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[9] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + choiceVariant(A, B, C) + blockWord[14] + abs(sin(26)) * 4294967296), 9)
-  choiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[14] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + choiceVariant(D, A, B) + blockWord[3] + abs(sin(27)) * 4294967296), 14)
-  choiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[3] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 14);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + choiceVariant(C, D, A) + blockWord[8] + abs(sin(28)) * 4294967296), 20)
-  choiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[8] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 20);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + choiceVariant(B, C, D) + blockWord[13] + abs(sin(29)) * 4294967296), 5)
-  choiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[13] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 5);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + choiceVariant(A, B, C) + blockWord[2] + abs(sin(30)) * 4294967296), 9)
-  choiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[2] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 9);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + choiceVariant(D, A, B) + blockWord[7] + abs(sin(31)) * 4294967296), 14)
-  choiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[7] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 14);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + choiceVariant(C, D, A) + blockWord[12] + abs(sin(32)) * 4294967296), 20)
-  choiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[12] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 20);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
+/*
+  Loads the 16 words of one 64 byte block from each of 8 lanes, so that
+  words[pos] holds word pos of every lane. Big endian words have their bytes
+  swapped on the way in.
 
-  /* Round 2 Operations Finish */
+  Used in:
+  - MD4, MD5, SHA1, SHA224, SHA256
+*/
+__attribute__((target("avx2")))
+inline void loadWords8x32(const uint8_t *blocks[8], __m256i words[16], bool bigEndian) {
+  const __m256i byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
 
-  /* Round 3 Operations Start */
+  for(short half = 0; half < 2; ++half) {
+    for(short lane = 0; lane < 8; ++lane)
+      words[half * 8 + lane] = _mm256_loadu_si256((const __m256i *)(blocks[lane] + half * 32));
 
-  // A = B + rotationalLeftShift((A + parity(B, C, D) + blockWord[5] + abs(sin(33)) * 4294967296), 4)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[5] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 4);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + parity(A, B, C) + blockWord[8] + abs(sin(34)) * 4294967296), 11)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[8] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + parity(D, A, B) + blockWord[11] + abs(sin(35)) * 4294967296), 16)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[11] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 16);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + parity(C, D, A) + blockWord[14] + abs(sin(36)) * 4294967296), 23)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[14] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 23);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + parity(B, C, D) + blockWord[1] + abs(sin(37)) * 4294967296), 4)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[1] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 4);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + parity(A, B, C) + blockWord[4] + abs(sin(38)) * 4294967296), 11)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[4] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + parity(D, A, B) + blockWord[7] + abs(sin(39)) * 4294967296), 16)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[7] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 16);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + parity(C, D, A) + blockWord[10] + abs(sin(40)) * 4294967296), 23)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[10] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 23);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + parity(B, C, D) + blockWord[13] + abs(sin(41)) * 4294967296), 4)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[13] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 4);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + parity(A, B, C) + blockWord[0] + abs(sin(42)) * 4294967296), 11)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[0] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + parity(D, A, B) + blockWord[3] + abs(sin(43)) * 4294967296), 16)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[3] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 16);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + parity(C, D, A) + blockWord[6] + abs(sin(44)) * 4294967296), 23)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[6] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 23);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + parity(B, C, D) + blockWord[9] + abs(sin(45)) * 4294967296), 4)
-  parity(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[9] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 4);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + parity(A, B, C) + blockWord[12] + abs(sin(46)) * 4294967296), 11)
-  parity(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[12] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 11);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + parity(D, A, B) + blockWord[15] + abs(sin(47)) * 4294967296), 16)
-  parity(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[15] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 16);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + parity(C, D, A) + blockWord[2] + abs(sin(48)) * 4294967296), 23)
-  parity(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[2] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 23);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
+    transpose8x32(words + half * 8);
+  }
 
-  /* Round 3 Operations Finish */
+  if(bigEndian)
+    for(short pos = 0; pos < 16; ++pos)
+      words[pos] = _mm256_shuffle_epi8(words[pos], byteSwap);
+}
 
-  /* Round 4 Operations Start */
+__attribute__((target("avx2")))
+inline __m256i rotationalRightShift8x32(__m256i val, int count) {
+  return _mm256_or_si256(_mm256_srli_epi32(val, count), _mm256_slli_epi32(val, 32 - count));
+}
 
-  // A = B + rotationalLeftShift((A + weirdChoice(B, C, D) + blockWord[0] + abs(sin(49)) * 4294967296), 6)
-  weirdChoiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[0] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 6);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + weirdChoice(A, B, C) + blockWord[7] + abs(sin(50)) * 4294967296), 10)
-  weirdChoiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[7] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 10);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + weirdChoice(D, A, B) + blockWord[14] + abs(sin(51)) * 4294967296), 15)
-  weirdChoiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[14] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + weirdChoice(C, D, A) + blockWord[5] + abs(sin(52)) * 4294967296), 21)
-  weirdChoiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[5] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 21);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + weirdChoice(B, C, D) + blockWord[12] + abs(sin(53)) * 4294967296), 6)
-  weirdChoiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[12] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 6);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + weirdChoice(A, B, C) + blockWord[3] + abs(sin(54)) * 4294967296), 10)
-  weirdChoiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[3] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 10);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + weirdChoice(D, A, B) + blockWord[10] + abs(sin(55)) * 4294967296), 15)
-  weirdChoiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[10] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + weirdChoice(C, D, A) + blockWord[1] + abs(sin(56)) * 4294967296), 21)
-  weirdChoiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[1] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 21);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + weirdChoice(B, C, D) + blockWord[8] + abs(sin(57)) * 4294967296), 6)
-  weirdChoiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[8] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 6);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + weirdChoice(A, B, C) + blockWord[15] + abs(sin(58)) * 4294967296), 10)
-  weirdChoiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[15] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 10);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + weirdChoice(D, A, B) + blockWord[6] + abs(sin(59)) * 4294967296), 15)
-  weirdChoiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[6] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + weirdChoice(C, D, A) + blockWord[13] + abs(sin(60)) * 4294967296), 21)
-  weirdChoiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[13] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 21);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
-
-  // A = B + rotationalLeftShift((A + weirdChoice(B, C, D) + blockWord[4] + abs(sin(61)) * 4294967296), 6)
-  weirdChoiceVariant(workingWord, stateRegisters[1], stateRegisters[2], stateRegisters[3]);
-  workingVal = stateRegisters[0] + translateWord(workingWord, 32) + wordArray[4] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 6);
-  workingVal = (stateRegisters[1] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[0] = (uint32_t)workingVal;
-
-  // D = A + rotationalLeftShift((D + weirdChoice(A, B, C) + blockWord[11]] + abs(sin(62)) * 4294967296), 10)
-  weirdChoiceVariant(workingWord, stateRegisters[0], stateRegisters[1], stateRegisters[2]);
-  workingVal = stateRegisters[3] + translateWord(workingWord, 32) + wordArray[11] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 10);
-  workingVal = (stateRegisters[0] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[3] = (uint32_t)workingVal;
-
-  // C = D + rotationalLeftShift((C + weirdChoice(D, A, B) + blockWord[2] + abs(sin(63)) * 4294967296), 15)
-  weirdChoiceVariant(workingWord, stateRegisters[3], stateRegisters[0], stateRegisters[1]);
-  workingVal = stateRegisters[2] + translateWord(workingWord, 32) + wordArray[2] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 15);
-  workingVal = (stateRegisters[3] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[2] = (uint32_t)workingVal;
-
-  // B = C + rotationalLeftShift((B + weirdChoice(C, D, A) + blockWord[9] + abs(sin(64)) * 4294967296), 21)
-  weirdChoiceVariant(workingWord, stateRegisters[2], stateRegisters[3], stateRegisters[0]);
-  workingVal = stateRegisters[1] + translateWord(workingWord, 32) + wordArray[9] +
-               (abs(sin(sineTrack++)) * 4294967296);
-  temp = workingVal % 4294967296;
-  rotationalLeftShift(workingWord, temp, 21);
-  workingVal = (stateRegisters[2] + translateWord(workingWord, 32)) % 4294967296;
-  stateRegisters[1] = (uint32_t)workingVal;
+__attribute__((target("avx2")))
+inline __m256i rotationalLeftShift8x32(__m256i val, int count) {
+  return _mm256_or_si256(_mm256_slli_epi32(val, count), _mm256_srli_epi32(val, 32 - count));
+}
 
-  /* Round 4 Operations Finish */
+__attribute__((target("avx2")))
+inline __m256i rotationalRightShift4x64(__m256i val, int count) {
+  return _mm256_or_si256(_mm256_srli_epi64(val, count), _mm256_slli_epi64(val, 64 - count));
 }
 
-string md5(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-                                          // of the pad buffer
+#endif
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
+/*
+  Shared Merkle-Damgard context, specialized for each hash by its traits and
+  explicitly instantiated in that hash's section below
 
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
+  Used in:
+  - MD4, MD5, SHA0, SHA1, SHA224, SHA256, SHA384, SHA512, SHA512/224,
+    SHA512/256, SHA512/t
+*/
+template<typename Traits>
+MerkleDamgardCtx<Traits>::MerkleDamgardCtx() : MerkleDamgardCtx(Traits::startingState()) {}
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+template<typename Traits>
+MerkleDamgardCtx<Traits>::MerkleDamgardCtx(const typename Traits::Word startingState[]) {
+  // Fill initial state registers
+  for(size_t pos = 0; pos < Traits::stateWords; ++pos)
+    registers[pos] = startingState[pos];
 
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  bufferLength = 0;
+  messageLength = 0;
+}
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+template<typename Traits>
+void MerkleDamgardCtx<Traits>::update(const void *data, size_t length) {
+  const size_t blockSize = Traits::blockSize;
+  const uint8_t *bytes = (const uint8_t *)data;
+  messageLength += length;
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  // Top up a partially filled block first
+  if(bufferLength > 0) {
+    size_t fill = min(length, blockSize - bufferLength);
+    memcpy(buffer + bufferLength, bytes, fill);
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+    bufferLength += fill;
+    bytes += fill;
+    length -= fill;
 
-  padPos = padLength - 64;
+    if(bufferLength < blockSize)
+      return;
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+    Traits::processBlock(buffer, registers);
+    bufferLength = 0;
+  }
 
-  // Create a byte array using the individual bytes of the saved message length
-  // before padding, using little endian convention
-  uint64_t val = lengthHolder;
+  // Process whole blocks straight out of the passed data
+  for(; length >= blockSize; bytes += blockSize, length -= blockSize)
+    Traits::processBlock(bytes, registers);
 
-  uint8_t byteArray[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  // Keep the remainder for the next call
+  memcpy(buffer, bytes, length);
+  bufferLength = length;
+}
 
-  for(short byte = 0; byte < 8; ++byte)
-    switch(byte) {
-      case 0:
-        byteArray[byte] = (lengthHolder >> 0) & 255;
-        break;
+template<typename Traits>
+void MerkleDamgardCtx<Traits>::update(string_view data) {
+  update(data.data(), data.length());
+}
 
-      case 1:
-        byteArray[byte] = (lengthHolder >> 8) & 255;
-        break;
+template<typename Traits>
+Digest<Traits::digestSize> MerkleDamgardCtx<Traits>::finalizeDigest() {
+  const size_t blockSize = Traits::blockSize;
+  const size_t lengthPos = blockSize - Traits::lengthBytes;
+  const size_t wordSize = sizeof(typename Traits::Word);
+  uint128_t lengthHolder = (uint128_t)messageLength * 8; // Message length in bits
+
+  // Add a 1 bit followed by 0s until only the length field remains in the
+  // final block. If the 1 bit doesn't leave enough room for the length, the
+  // current block is padded out and processed and the length goes into a
+  // second one
+  buffer[bufferLength++] = 128;
+
+  if(bufferLength > lengthPos) {
+    memset(buffer + bufferLength, 0, blockSize - bufferLength);
+    Traits::processBlock(buffer, registers);
+    bufferLength = 0;
+  }
 
-      case 2:
-        byteArray[byte] = (lengthHolder >> 16) & 255;
-        break;
+  memset(buffer + bufferLength, 0, lengthPos - bufferLength);
 
-      case 3:
-        byteArray[byte] = (lengthHolder >> 24) & 255;
-        break;
+  // Append the message length before padding in the hash's byte order
+  for(size_t byte = 0; byte < Traits::lengthBytes; ++byte) {
+    size_t shift = 8 * (Traits::bigEndian ? Traits::lengthBytes - 1 - byte : byte);
+    buffer[lengthPos + byte] = (lengthHolder >> shift) & 255;
+  }
 
-      case 4:
-        byteArray[byte] = (lengthHolder >> 32) & 255;
-        break;
+  Traits::processBlock(buffer, registers);
 
-      case 5:
-        byteArray[byte] = (lengthHolder >> 40) & 255;
-        break;
+  // Translate final register state values into an array of bytes in the same
+  // byte order, keeping only the first digestSize of them
+  Digest<Traits::digestSize> digest;
+  for(size_t pos = 0; pos < Traits::digestSize; ++pos) {
+    size_t shift = 8 * (Traits::bigEndian ? wordSize - 1 - pos % wordSize : pos % wordSize);
+    digest[pos] = (registers[pos / wordSize] >> shift) & 255;
+  }
 
-      case 6:
-        byteArray[byte] = (lengthHolder >> 48) & 255;
-        break;
+  return digest;
+}
 
-      case 7:
-        byteArray[byte] = (lengthHolder >> 56) & 255;
-    }
+template<typename Traits>
+string MerkleDamgardCtx<Traits>::finalize() {
+  Digest<Traits::digestSize> digest = finalizeDigest();
 
-  // Append byte array into the remaining space of the pad buffer as individual
-  // bits
-  for(uint8_t val: byteArray)
-    for(short bitPos = 7; bitPos >= 0; --bitPos) {
-      bool bit = val & (1l << bitPos);
+  return hexDigest(digest.data(), digest.size());
+}
 
-      padBuffer[padPos++] = bit;
-    }
-
-  // Create and fill initial state registers
-  uint32_t registers[4];
-
-  for(short count = 0; count < 4; ++count)
-    switch(count) {
-      case 0:
-        registers[count] = 1732584193;  // 0x67452301
-        break;
-
-      case 1:
-        registers[count] = 4023233417;  // 0xefcdab89
-        break;
-
-      case 2:
-        registers[count] = 2562383102;  // 0x98badcfe
-        break;
-
-      case 3:
-        registers[count] = 271733878;   // 0x10325476
-    }
+/*---------------------------------------------------------------------------*/
+/*                             Begin MD2 Section                             */
+/*---------------------------------------------------------------------------*/
 
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
+/*
+  MD2 Algorithm designed using the specifications described in
 
-  int blockTrack = 0;
-  uint32_t registerStateSave[4];
+  RFC 1319
 
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
+  Published in April 1992
+*/
 
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for (uint32_t val: registers)
-        registerStateSave[pos++] = val;
 
-      md5processBlock(block, registers);
+// Create substitution table (S table) for calculating the checksum and hash
+// digest
+const uint8_t subTable[256] = {41, 46, 67, 201, 162, 216, 124, 1, 61, 54, 84, 161,
+                               236, 240, 6, 19, 98, 167, 5, 243, 192, 199, 115, 140,
+                               152, 147, 43, 217, 188, 76, 130, 202, 30, 155, 87, 60,
+                               253, 212, 224, 22, 103, 66, 111, 24, 138, 23, 229, 18,
+                               190, 78, 196, 214, 218, 158, 222, 73, 160, 251, 245,
+                               142, 187, 47, 238, 122, 169, 104, 121, 145, 21, 178, 7,
+                               63, 148, 194, 16, 137, 11, 34, 95, 33, 128, 127, 93,
+                               154, 90, 144, 50, 39, 53, 62, 204, 231, 191, 247, 151,
+                               3, 255, 25, 48, 179, 72, 165, 181, 209, 215, 94, 146,
+                               42, 172, 86, 170, 198, 79, 184, 56, 210, 150, 164, 125,
+                               182, 118, 252, 107, 226, 156, 116, 4, 241, 69, 157,
+                               112, 89, 100, 113, 135, 32, 134, 91, 207, 101, 230, 45,
+                               168, 2, 27, 96, 37, 173, 174, 176, 185, 246, 28, 70,
+                               97, 105, 52, 64, 126, 15, 85, 71, 163, 35, 221, 81,
+                               175, 58, 195, 92, 249, 206, 186, 197, 234, 38, 44, 83,
+                               13, 110, 133, 40, 132, 9, 211, 223, 205, 244, 65, 129,
+                               77, 82, 106, 220, 55, 200, 108, 193, 171, 250, 36,
+                               225, 123, 8, 12, 189, 177, 74, 120, 136, 149, 139,
+                               227, 99, 232, 109, 233, 203, 213, 254, 59, 0, 29, 57,
+                               242, 239, 183, 14, 102, 88, 208, 228, 166, 119, 114,
+                               248, 235, 117, 75, 10, 49, 68, 80, 180, 143, 237, 31,
+                               26, 219, 153, 141, 51, 159, 17, 131, 20};
 
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 4; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(registers[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
 
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+/*
+  Runs a single 16 byte block through the checksum calculation. The last
+  checksum byte (L in RFC 1319) is carried over between blocks.
+*/
+void md2updateCheckSum(const uint8_t block[16], uint8_t checkSum[16], uint8_t &l) {
+  for(short pos = 0; pos < 16; ++pos)
+    l = checkSum[pos] ^= subTable[block[pos] ^ l];
+}
 
-        uint32_t newStateVal = tempVal % 4294967296;
+void md2processBlock(const uint8_t block[16], uint8_t messageDigest[48]) {
+  // Copy current block into the second part of the message digest and the
+  // XOR of the block and the first part into the third
+  for(short pos = 0; pos < 16; ++pos) {
+    messageDigest[16 + pos] = block[pos];
+    messageDigest[32 + pos] = block[pos] ^ messageDigest[pos];
+  }
 
-        registers[pointer] = newStateVal;
+  uint8_t t = 0;
 
-        tempVal = 0;
-      }
+  // Process 18 rounds of compression
+  for(short round = 0; round < 18; ++round) {
+    // Run round, setting t and the current byte in the digest to the
+    // substituted value
+    for(short pos = 0; pos < 48; ++pos)
+      t = messageDigest[pos] ^= subTable[t];
 
-      blockTrack = 0;
-    }
+    // set t to (t + round) % 256 through unsigned overflow
+    t += round;
   }
+}
 
-  // Translate final register state values into an array of bytes, arranged in
-  // little endian convention
-  uint8_t digestArray[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+#if defined(__x86_64__) || defined(__i386__)
 
-  short byteTracker = 0;
-  for(uint32_t registerVal: registers) {
-    digestArray[byteTracker++] = (registerVal >> 0) & 255;
-    digestArray[byteTracker++] = (registerVal >> 8) & 255;
-    digestArray[byteTracker++] = (registerVal >> 16) & 255;
-    digestArray[byteTracker++] = (registerVal >> 24) & 255;
+/*
+  Multi-buffer MD2, running one block from each of 32 independent messages
+  side by side, one message per byte lane
+
+  Every step of MD2 is a lookup into the substitution table, so the table is
+  split into 16 rows of 16 bytes and looked up with byte shuffles. Each row's
+  shuffle only keeps the lanes whose high nibble selects that row: XORing
+  the row number out of the high nibble and adding 0x70 with saturation
+  leaves a valid shuffle index there, and sets the top bit (giving 0)
+  everywhere else.
+*/
+__attribute__((target("avx2")))
+inline __m256i md2SubstituteX32(const __m256i table[16], __m256i index) {
+  const __m256i selectRow = _mm256_set1_epi8(0x70);
+
+  __m256i result = _mm256_setzero_si256();
+  for(short row = 0; row < 16; ++row) {
+    __m256i rowIndex = _mm256_adds_epu8(_mm256_xor_si256(index, _mm256_set1_epi8(row << 4)), selectRow);
+    result = _mm256_or_si256(result, _mm256_shuffle_epi8(table[row], rowIndex));
   }
 
-  return hexDigest(digestArray, 16);
+  return result;
 }
 
-/*---------------------------------------------------------------------------*/
-/*                            Begin SHA0 Section                             */
-/*---------------------------------------------------------------------------*/
-
 /*
-  SHA0 Algorithm designed using the specifications described in
-
-  NIST FIPS Pub 180
-
-  Published in May 1993
+  state holds the 48 byte message digest, 16 byte checksum and the last
+  checksum byte of every lane, byte-major. Lanes whose entry in
+  updateCheckSum is 0 are processing their checksum as the final block and
+  leave it untouched.
 */
+struct Md2BatchState {
+  alignas(32) uint8_t messageDigest[48][32];
+  alignas(32) uint8_t checkSum[16][32];
+  alignas(32) uint8_t checkSumLast[32];
+  alignas(32) uint8_t updateCheckSum[32];
+};
+
+__attribute__((target("avx2")))
+void md2processBlocks32AVX2(const uint8_t *blocks[32], Md2BatchState &state) {
+  __m256i table[16];
+  for(short row = 0; row < 16; ++row)
+    table[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(subTable + row * 16)));
+
+  // Transpose the blocks so that each vector holds the same byte of all 32
+  alignas(32) uint8_t transposed[16][32];
+  for(short lane = 0; lane < 32; ++lane)
+    for(short pos = 0; pos < 16; ++pos)
+      transposed[pos][lane] = blocks[lane][pos];
+
+  __m256i *messageDigest = (__m256i *)state.messageDigest;
+  __m256i *checkSum = (__m256i *)state.checkSum;
+
+  /* Update the checksum */
+  __m256i updateMask = _mm256_load_si256((const __m256i *)state.updateCheckSum);
+  __m256i l = _mm256_load_si256((const __m256i *)state.checkSumLast);
+
+  for(short pos = 0; pos < 16; ++pos) {
+    __m256i block = _mm256_load_si256((const __m256i *)transposed[pos]);
+    __m256i updated = _mm256_xor_si256(checkSum[pos], md2SubstituteX32(table, _mm256_xor_si256(block, l)));
+
+    checkSum[pos] = _mm256_blendv_epi8(checkSum[pos], updated, updateMask);
+    l = _mm256_blendv_epi8(l, updated, updateMask);
+  }
 
-// Schedule generation function used by SHA0
-void generateScheduleSHA0(bool block[512], uint32_t schedule[80]) {
-  // Create the first 16 32-bit words using the message block
-  short bitCount = 0;
-  short schedulePos = 0;
-  short bitPos = 31;
-  bool word[32];
-  for(int blockCount = 0; blockCount < 512; ++blockCount) {
-    word[bitCount] = block[blockCount];
-    ++bitCount;
-
-    if(bitCount == 32) {
-      uint32_t val = 0;
-
-      for (bool wordBit: word) {
-        if (wordBit)
-          val += 1 << bitPos;
-        --bitPos;
-      }
+  _mm256_store_si256((__m256i *)state.checkSumLast, l);
 
-      schedule[schedulePos] = val;
-      ++schedulePos;
+  /* Process the block */
+  for(short pos = 0; pos < 16; ++pos) {
+    __m256i block = _mm256_load_si256((const __m256i *)transposed[pos]);
 
-      bitCount = 0;
-      bitPos = 31;
-    }
+    messageDigest[16 + pos] = block;
+    messageDigest[32 + pos] = _mm256_xor_si256(block, messageDigest[pos]);
   }
 
-  // Expand the schedule to 80 32-bit words
-  uint32_t val1, val2, val3, val4;
-  uint32_t result;
-  while(schedulePos < 80) {
-    val1 = schedule[schedulePos - 3];
-    val2 = schedule[schedulePos - 8];
-    val3 = schedule[schedulePos - 14];
-    val4 = schedule[schedulePos - 16];
-
-    result = val1 ^ val2 ^ val3 ^ val4;
-    schedule[schedulePos++] = result;
+  __m256i t = _mm256_setzero_si256();
+
+  for(short round = 0; round < 18; ++round) {
+    for(short pos = 0; pos < 48; ++pos)
+      t = messageDigest[pos] = _mm256_xor_si256(messageDigest[pos], md2SubstituteX32(table, t));
+
+    t = _mm256_add_epi8(t, _mm256_set1_epi8(round));
   }
 }
 
-void sha0processBlock(bool block[512], uint32_t registers[5], uint32_t constants[80]) {
-  /* Create message schedule */
-  uint32_t schedule[80];
+#endif
 
-  generateScheduleSHA0(block, schedule);
+Md2Ctx::Md2Ctx() {
+  // Zero out message digest and checksum
+  memset(messageDigest, 0, sizeof(messageDigest));
+  memset(checkSum, 0, sizeof(checkSum));
 
-  /* Begin compression process */
-  for(short round = 0; round < 80; ++round) {
-    uint32_t scheduleWord = schedule[round];
-    uint32_t constantWord = constants[round];
-
-    /* Create temporary 32-bit word used to help change the state registers */
-
-    // Create first temp word by passing the value in the first register to the
-    // rotational left shift function with a shift value of 5
-    bool tempWord1[32];
-    rotationalLeftShift(tempWord1, registers[0], 5);
-
-    // Create second temp word by passing the values in registers 2, 3 and 4 to
-    // the proper function based on the current round
-    bool tempWord2[32];
-    if(round < 20)
-      oldChoice(tempWord2, registers[1], registers[2], registers[3]);
-    else if((round >= 20 && round < 40) || (round >= 60))
-      parity(tempWord2, registers[1], registers[2], registers[3]);
-    else
-      oldMajority(tempWord2, registers[1], registers[2], registers[3]);
-
-    // Temp word 3 is simply the 5th register, temp word 4 is the schedule word,
-    // temp word 5 is the constant word
-    uint32_t val = registers[4];
-    bool tempWord3[32];
-    bool tempWord4[32];
-    bool tempWord5[32];
-    short wordPos = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      tempWord3[bitPos] = val & (1l << wordPos);
-      tempWord4[bitPos] = scheduleWord & (1l << wordPos);
-      tempWord5[bitPos] = constantWord & (1l << wordPos);
-
-      ++wordPos;
-    }
+  checkSumLast = 0;
+  bufferLength = 0;
+}
 
-    // Add all words up taken at module 2^32 to get the final temp word
-    unsigned long finalTempVal = 0;
+void Md2Ctx::processBlock(const uint8_t block[]) {
+  md2updateCheckSum(block, checkSum, checkSumLast);
+  md2processBlock(block, messageDigest);
+}
 
-    int bitTrack = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      if(tempWord1[bitPos])
-        finalTempVal += 1l << bitTrack;
+void Md2Ctx::update(const void *data, size_t length) {
+  const uint8_t *bytes = (const uint8_t *)data;
 
-      if(tempWord2[bitPos])
-        finalTempVal += 1l << bitTrack;
+  // Top up a partially filled block first
+  if(bufferLength > 0) {
+    size_t fill = min(length, 16 - bufferLength);
+    memcpy(buffer + bufferLength, bytes, fill);
 
-      if(tempWord3[bitPos])
-        finalTempVal += 1l << bitTrack;
+    bufferLength += fill;
+    bytes += fill;
+    length -= fill;
 
-      if(tempWord4[bitPos])
-        finalTempVal += 1l << bitTrack;
+    if(bufferLength < 16)
+      return;
 
-      if(tempWord5[bitPos])
-        finalTempVal += 1l << bitTrack;
+    processBlock(buffer);
+    bufferLength = 0;
+  }
 
-      ++bitTrack;
-    }
+  // Process whole blocks straight out of the passed data
+  for(; length >= 16; bytes += 16, length -= 16)
+    processBlock(bytes);
 
-    uint32_t finalVal = finalTempVal % 4294967296;
+  // Keep the remainder for the next call
+  memcpy(buffer, bytes, length);
+  bufferLength = length;
+}
 
-    /* Update state registers */
+void Md2Ctx::update(string_view data) {
+  update(data.data(), data.length());
+}
 
-    // Shift all register values to the right, discarding the value held in
-    // register 5. Third register is replaced by the value of register 2
-    // with a rotational left shift of 30 performed on it.
-    for(int iter = 4; iter > 0; --iter)
-      if(iter == 2) {
-        bool tempWord[32];
-        rotationalLeftShift(tempWord, registers[iter - 1], 30);
+Digest<16> Md2Ctx::finalizeDigest() {
+  // MD2 pads to a multiple of 16 bytes with bytes holding the pad length.
+  // Padding is still performed even if the message length is a multiple of
+  // 16 bytes
+  uint8_t padValue = 16 - bufferLength;
+  memset(buffer + bufferLength, padValue, padValue);
 
-        uint32_t val = 0;
-        short bitPos = 31;
-        for(bool bit: tempWord) {
-          if(bit)
-            val += 1l << bitPos;
-          --bitPos;
-        }
+  processBlock(buffer);
 
-        registers[iter] = val;
-      } else
-        registers[iter] = registers[iter - 1];
+  // The checksum is processed as one final block without being fed back into
+  // itself
+  md2processBlock(checkSum, messageDigest);
 
-    // Replace the value in the first register with our generated temporary
-    // value
-    registers[0] = finalVal;
-  }
+  // The resulting hash is held in the first 16 bytes of the message digest
+  Digest<16> digest;
+  memcpy(digest.data(), messageDigest, 16);
+
+  return digest;
 }
 
-string sha0(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-                                          // of the pad buffer
+string Md2Ctx::finalize() {
+  Digest<16> digest = finalizeDigest();
+
+  return hexDigest(digest.data(), digest.size());
+}
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
+string md2(const void *data, size_t length) {
+  Md2Ctx ctx;
+  ctx.update(data, length);
 
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
+  return ctx.finalize();
+}
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+string md2(string_view data) {
+  return md2(data.data(), data.length());
+}
 
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+Digest<16> md2Digest(const void *data, size_t length) {
+  Md2Ctx ctx;
+  ctx.update(data, length);
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+  return ctx.finalizeDigest();
+}
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+Digest<16> md2Digest(string_view data) {
+  return md2Digest(data.data(), data.length());
+}
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+/*
+  Hashes every message of a batch, 32 at a time with AVX2 or otherwise one
+  after another
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+  Each lane works through the whole blocks of its message, then its padded
+  final block and finally its own checksum, after which the lane is refilled
+  with the next waiting message. Once no messages are left, idle lanes are
+  fed a dummy block and their results discarded.
+*/
+vector<Digest<16>> md2Batch(const string_view data[], size_t count) {
+  vector<Digest<16>> digests(count);
+
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2 && calibratedBatchLanes(batchMd2, data, count) != 1) {
+    struct Lane {
+      bool active;
+      size_t message;
+      const uint8_t *data;
+      size_t wholeBlocks;
+      size_t block;
+      uint8_t tail[16];
+    };
+
+    static const uint8_t idleBlock[16] = {};
+
+    Lane lane[32];
+    Md2BatchState state;
+    const uint8_t *blocks[32];
+
+    size_t nextMessage = 0;
+    size_t activeLanes = 0;
+
+    // Loads the next waiting message into a lane, padding its final block
+    auto refill = [&](short pos) {
+      Lane &current = lane[pos];
+      current.active = nextMessage < count;
+
+      if(!current.active)
+        return;
+
+      string_view message = data[nextMessage];
+      size_t remainder = message.length() % 16;
+
+      current.message = nextMessage++;
+      current.data = (const uint8_t *)message.data();
+      current.wholeBlocks = message.length() / 16;
+      current.block = 0;
+
+      memcpy(current.tail, current.data + current.wholeBlocks * 16, remainder);
+      memset(current.tail + remainder, 16 - remainder, 16 - remainder);
+
+      for(short byte = 0; byte < 48; ++byte)
+        state.messageDigest[byte][pos] = 0;
+      for(short byte = 0; byte < 16; ++byte)
+        state.checkSum[byte][pos] = 0;
+      state.checkSumLast[pos] = 0;
+
+      ++activeLanes;
+    };
+
+    for(short pos = 0; pos < 32; ++pos)
+      refill(pos);
+
+    while(activeLanes > 0) {
+      for(short pos = 0; pos < 32; ++pos) {
+        Lane &current = lane[pos];
+        state.updateCheckSum[pos] = 255;
+
+        if(!current.active) {
+          blocks[pos] = idleBlock;
+        } else if(current.block < current.wholeBlocks) {
+          blocks[pos] = current.data + current.block * 16;
+        } else if(current.block == current.wholeBlocks) {
+          blocks[pos] = current.tail;
+        } else {
+          // The checksum is processed as one final block without being fed
+          // back into itself
+          for(short byte = 0; byte < 16; ++byte)
+            current.tail[byte] = state.checkSum[byte][pos];
+
+          blocks[pos] = current.tail;
+          state.updateCheckSum[pos] = 0;
+        }
+      }
 
-  padPos = padLength - 1;
+      md2processBlocks32AVX2(blocks, state);
 
-  uint64_t val = lengthHolder;
-  uint64_t temp = 0;
+      for(short pos = 0; pos < 32; ++pos) {
+        Lane &current = lane[pos];
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 63; ++bitPos) {
-    bool bit = val & (1l << bitPos);
+        if(!current.active || ++current.block <= current.wholeBlocks + 1)
+          continue;
 
-    padBuffer[padPos] = bit;
+        // The resulting hash is held in the first 16 bytes of the message
+        // digest
+        for(short byte = 0; byte < 16; ++byte)
+          digests[current.message][byte] = state.messageDigest[byte][pos];
 
-    if(bit) {
-      temp += 1l << bitPos;
-      if(temp == val)
-        break;
+        --activeLanes;
+        refill(pos);
+      }
     }
 
-    --padPos;
+    return digests;
   }
+#endif
 
-  // Create constants array and initial state registers
-  uint32_t constants[80];
-  uint32_t stateRegisters[5];
-
-  // Fill constants array
-  for(short count = 0; count < 80; ++count)
-    if(count < 20)
-      constants[count] = 1518500249;    // 0x5a827999
-    else if(count >= 20 && count < 40)
-      constants[count] = 1859775393;    // 0x6ed9eba1
-    else if(count >= 30 && count < 60)
-      constants[count] = 2400959708;    // 0x8f1bbcdc
-    else
-      constants[count] = 3395469782;    // 0xca62c1d6
+  for(size_t message = 0; message < count; ++message) {
+    Md2Ctx ctx;
+    ctx.update(data[message]);
+    digests[message] = ctx.finalizeDigest();
+  }
 
-  // Fill initial state registers
-  for(short count = 0; count < 5; ++count)
-    switch(count) {
-      case 0:
-        stateRegisters[count] = 1732584193;  // 0x67452301
-        break;
+  return digests;
+}
 
-      case 1:
-        stateRegisters[count] = 4023233417;  // 0xefcdab89
-        break;
+vector<Digest<16>> md2Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-      case 2:
-        stateRegisters[count] = 2562383102;  // 0x98badcfe
-        break;
+  return md2Batch(views.data(), views.size());
+}
 
-      case 3:
-        stateRegisters[count] = 271733878;   // 0x10325476
-        break;
+/*---------------------------------------------------------------------------*/
+/*                             Begin MD4 Section                             */
+/*---------------------------------------------------------------------------*/
 
-      case 4:
-        stateRegisters[count] = 3285377520;  // 0xc3d2e1f0
-    }
+/*
+  MD4 Algorithm designed using the specifications described in
 
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
+  RFC 1320
 
-  int blockTrack = 0;
-  uint32_t registerStateSave[5];
+  Published in April 1992
+*/
 
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
+/*
+  Single operations of each of the three rounds, defined as follows:
 
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for (uint32_t val: stateRegisters)
-        registerStateSave[pos++] = val;
+  A = rotationalLeftShift((A + F(B, C, D) + blockWord + constant), shift)
 
-      sha0processBlock(block, stateRegisters, constants);
+  With F being oldChoice, oldMajority and parity for rounds 1 through 3
+  respectively, and the constant being 0, 0x5a827999 and 0x6ed9eba1. All
+  additions are taken modulo 2^32 through unsigned overflow.
+*/
+inline void md4Round1Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          unsigned int shift) {
+  a = rotationalLeftShift(a + oldChoice(b, c, d) + word, shift);
+}
 
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 5; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
+inline void md4Round2Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          unsigned int shift) {
+  a = rotationalLeftShift(a + oldMajority(b, c, d) + word + 1518500249, shift);
+}
 
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+inline void md4Round3Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          unsigned int shift) {
+  a = rotationalLeftShift(a + parity(b, c, d) + word + 1859775393, shift);
+}
 
-        uint32_t newStateVal = tempVal % 4294967296;
+void md4processBlock(const uint8_t block[64], uint32_t stateRegisters[4]) {
+  // Translate block into an array of 16 32 bit words using little endian
+  // convention
+  uint32_t wordArray[16];
+  for(short wordTrack = 0; wordTrack < 16; ++wordTrack)
+    wordArray[wordTrack] = loadLittleEndian32(block + wordTrack * 4);
 
-        stateRegisters[pointer] = newStateVal;
+  uint32_t a = stateRegisters[0];
+  uint32_t b = stateRegisters[1];
+  uint32_t c = stateRegisters[2];
+  uint32_t d = stateRegisters[3];
 
-        tempVal = 0;
-      }
+  /* Round 1 Operations Start */
 
-      blockTrack = 0;
-    }
-  }
+  md4Round1Step(a, b, c, d, wordArray[0], 3);
+  md4Round1Step(d, a, b, c, wordArray[1], 7);
+  md4Round1Step(c, d, a, b, wordArray[2], 11);
+  md4Round1Step(b, c, d, a, wordArray[3], 19);
 
-  return hexDigest(stateRegisters, 5);
-}
+  md4Round1Step(a, b, c, d, wordArray[4], 3);
+  md4Round1Step(d, a, b, c, wordArray[5], 7);
+  md4Round1Step(c, d, a, b, wordArray[6], 11);
+  md4Round1Step(b, c, d, a, wordArray[7], 19);
 
-/*---------------------------------------------------------------------------*/
-/*                            Begin SHA1 Section                             */
-/*---------------------------------------------------------------------------*/
+  md4Round1Step(a, b, c, d, wordArray[8], 3);
+  md4Round1Step(d, a, b, c, wordArray[9], 7);
+  md4Round1Step(c, d, a, b, wordArray[10], 11);
+  md4Round1Step(b, c, d, a, wordArray[11], 19);
 
-/*
-  SHA1 Algorithm designed using the specifications described in
+  md4Round1Step(a, b, c, d, wordArray[12], 3);
+  md4Round1Step(d, a, b, c, wordArray[13], 7);
+  md4Round1Step(c, d, a, b, wordArray[14], 11);
+  md4Round1Step(b, c, d, a, wordArray[15], 19);
 
-  NIST FIPS Publication 180-4
+  /* Round 1 Operations Finish */
 
-  published in August 2015
-*/
+  /* Round 2 Operations Start */
 
-void generateScheduleSHA1(bool block[512], uint32_t schedule[80]) {
-  // Create the first 16 32-bit words using the message block
-  short bitCount = 0;
-  short schedulePos = 0;
-  short bitPos = 31;
-  bool word[32];
-  for(int blockCount = 0; blockCount < 512; ++blockCount) {
-    word[bitCount] = block[blockCount];
-    ++bitCount;
-
-    if(bitCount == 32) {
-      uint32_t val = 0;
-
-      for (bool wordBit: word) {
-        if (wordBit)
-            val += 1 << bitPos;
-        --bitPos;
-      }
+  md4Round2Step(a, b, c, d, wordArray[0], 3);
+  md4Round2Step(d, a, b, c, wordArray[4], 5);
+  md4Round2Step(c, d, a, b, wordArray[8], 9);
+  md4Round2Step(b, c, d, a, wordArray[12], 13);
 
-      schedule[schedulePos] = val;
-      ++schedulePos;
+  md4Round2Step(a, b, c, d, wordArray[1], 3);
+  md4Round2Step(d, a, b, c, wordArray[5], 5);
+  md4Round2Step(c, d, a, b, wordArray[9], 9);
+  md4Round2Step(b, c, d, a, wordArray[13], 13);
 
-      bitCount = 0;
-      bitPos = 31;
-    }
-  }
+  md4Round2Step(a, b, c, d, wordArray[2], 3);
+  md4Round2Step(d, a, b, c, wordArray[6], 5);
+  md4Round2Step(c, d, a, b, wordArray[10], 9);
+  md4Round2Step(b, c, d, a, wordArray[14], 13);
 
-  // Expand the schedule to 80 32-bit words
-  uint32_t val1, val2, val3, val4;
-  uint32_t result;
-  while(schedulePos < 80) {
-    val1 = schedule[schedulePos - 3];
-    val2 = schedule[schedulePos - 8];
-    val3 = schedule[schedulePos - 14];
-    val4 = schedule[schedulePos - 16];
-
-    result = val1 ^ val2 ^ val3 ^ val4;
-
-    bool scheduleWord[32];
-    rotationalLeftShift(scheduleWord, result, 1);
-
-    result = 0;
-    short bitPos = 31;
-    for(bool bit: scheduleWord) {
-      if(bit)
-        result += 1 << bitPos;
-      --bitPos;
-    }
+  md4Round2Step(a, b, c, d, wordArray[3], 3);
+  md4Round2Step(d, a, b, c, wordArray[7], 5);
+  md4Round2Step(c, d, a, b, wordArray[11], 9);
+  md4Round2Step(b, c, d, a, wordArray[15], 13);
 
-    schedule[schedulePos++] = result;
-  }
-}
+  /* Round 2 Operations Finish */
 
-void sha1processBlock(bool block[512], uint32_t registers[5], uint32_t constants[80]) {
-  /* Generate message schedule */
+  /* Round 3 Operations Start */
 
-  uint32_t schedule[80];
+  md4Round3Step(a, b, c, d, wordArray[0], 3);
+  md4Round3Step(d, a, b, c, wordArray[8], 9);
+  md4Round3Step(c, d, a, b, wordArray[4], 11);
+  md4Round3Step(b, c, d, a, wordArray[12], 15);
 
-  generateScheduleSHA1(block, schedule);
+  md4Round3Step(a, b, c, d, wordArray[2], 3);
+  md4Round3Step(d, a, b, c, wordArray[10], 9);
+  md4Round3Step(c, d, a, b, wordArray[6], 11);
+  md4Round3Step(b, c, d, a, wordArray[14], 15);
 
-  /* Begin compression process */
-  for(short round = 0; round < 80; ++round) {
-    uint32_t scheduleWord = schedule[round];
-    uint32_t constantWord = constants[round];
-
-    /* Create temporary 32-bit word used to help change the state registers */
-
-    // Create first temp word by passing the value in the first register to the
-    // rotational left shift function with a shift value of 5
-    bool tempWord1[32];
-    rotationalLeftShift(tempWord1, registers[0], 5);
-
-    // Create second temp word by passing the values in registers 2, 3 and 4 to
-    // the proper function based on the current round
-    bool tempWord2[32];
-    if(round < 20)
-      choice(tempWord2, registers[1], registers[2], registers[3]);
-    else if((round >= 20 && round < 40) || (round >= 60))
-      parity(tempWord2, registers[1], registers[2], registers[3]);
-    else
-      majority(tempWord2, registers[1], registers[2], registers[3]);
-
-    // Temp word 3 is simply the 5th register, temp word 4 is the schedule word,
-    // temp word 5 is the constant word
-    uint32_t val = registers[4];
-    bool tempWord3[32];
-    bool tempWord4[32];
-    bool tempWord5[32];
-    short wordPos = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      tempWord3[bitPos] = val & (1l << wordPos);
-      tempWord4[bitPos] = scheduleWord & (1l << wordPos);
-      tempWord5[bitPos] = constantWord & (1l << wordPos);
-
-      ++wordPos;
-    }
+  md4Round3Step(a, b, c, d, wordArray[1], 3);
+  md4Round3Step(d, a, b, c, wordArray[9], 9);
+  md4Round3Step(c, d, a, b, wordArray[5], 11);
+  md4Round3Step(b, c, d, a, wordArray[13], 15);
 
-    // Add all words up taken at module 2^32 to get the final temp word
-    unsigned long finalTempVal = 0;
+  md4Round3Step(a, b, c, d, wordArray[3], 3);
+  md4Round3Step(d, a, b, c, wordArray[11], 9);
+  md4Round3Step(c, d, a, b, wordArray[7], 11);
+  md4Round3Step(b, c, d, a, wordArray[15], 15);
 
-    int bitTrack = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      if(tempWord1[bitPos])
-        finalTempVal += 1l << bitTrack;
+  /* Round 3 Operations Finish */
 
-      if(tempWord2[bitPos])
-        finalTempVal += 1l << bitTrack;
+  // Add the processed registers onto the saved register state
+  stateRegisters[0] += a;
+  stateRegisters[1] += b;
+  stateRegisters[2] += c;
+  stateRegisters[3] += d;
+}
 
-      if(tempWord3[bitPos])
-        finalTempVal += 1l << bitTrack;
+#if defined(__x86_64__) || defined(__i386__)
 
-      if(tempWord4[bitPos])
-        finalTempVal += 1l << bitTrack;
+/*
+  Multi-buffer MD4, running one block from each of 8 independent messages
+  side by side, one message per 32 bit lane. The steps mirror the ones above
+  with every register holding the same word of all 8 lanes.
+*/
+__attribute__((target("avx2")))
+inline void md4Round1Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word, int shift) {
+  __m256i mix = _mm256_xor_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d));
+  a = rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix), word), shift);
+}
 
-      if(tempWord5[bitPos])
-        finalTempVal += 1l << bitTrack;
+__attribute__((target("avx2")))
+inline void md4Round2Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word, int shift) {
+  __m256i mix = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+  a = rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                               _mm256_add_epi32(word, _mm256_set1_epi32(1518500249))), shift);
+}
 
-      ++bitTrack;
-    }
+__attribute__((target("avx2")))
+inline void md4Round3Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word, int shift) {
+  __m256i mix = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  a = rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                               _mm256_add_epi32(word, _mm256_set1_epi32(1859775393))), shift);
+}
 
-    uint32_t finalVal = finalTempVal % 4294967296;
+__attribute__((target("avx2")))
+void md4processBlocks8AVX2(const uint8_t *blocks[8], uint32_t state[4][8]) {
+  __m256i words[16];
+  loadWords8x32(blocks, words, false);
 
-    /* Update state registers */
+  __m256i registers[4];
+  for(short pos = 0; pos < 4; ++pos)
+    registers[pos] = _mm256_load_si256((const __m256i *)state[pos]);
 
-    // Shift all register values to the right, discarding the value held in
-    // register 5. Third register is replaced by the value of register 2
-    // with a rotational left shift of 30 performed on it.
-    for(int iter = 4; iter > 0; --iter)
-      if(iter == 2) {
-        bool tempWord[32];
-        rotationalLeftShift(tempWord, registers[iter - 1], 30);
+  __m256i a = registers[0];
+  __m256i b = registers[1];
+  __m256i c = registers[2];
+  __m256i d = registers[3];
 
-        uint32_t val = 0;
-        short bitPos = 31;
-        for(bool bit: tempWord) {
-          if(bit)
-            val += 1l << bitPos;
-          --bitPos;
-        }
+  /* Round 1 Operations Start */
 
-        registers[iter] = val;
-      } else
-        registers[iter] = registers[iter - 1];
+  md4Round1Step8(a, b, c, d, words[0], 3);
+  md4Round1Step8(d, a, b, c, words[1], 7);
+  md4Round1Step8(c, d, a, b, words[2], 11);
+  md4Round1Step8(b, c, d, a, words[3], 19);
 
-    // Replace the value in the first register with our generated temporary
-    // value
-    registers[0] = finalVal;
-  }
-}
+  md4Round1Step8(a, b, c, d, words[4], 3);
+  md4Round1Step8(d, a, b, c, words[5], 7);
+  md4Round1Step8(c, d, a, b, words[6], 11);
+  md4Round1Step8(b, c, d, a, words[7], 19);
 
-string sha1(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-  // of the pad buffer
+  md4Round1Step8(a, b, c, d, words[8], 3);
+  md4Round1Step8(d, a, b, c, words[9], 7);
+  md4Round1Step8(c, d, a, b, words[10], 11);
+  md4Round1Step8(b, c, d, a, words[11], 19);
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
+  md4Round1Step8(a, b, c, d, words[12], 3);
+  md4Round1Step8(d, a, b, c, words[13], 7);
+  md4Round1Step8(c, d, a, b, words[14], 11);
+  md4Round1Step8(b, c, d, a, words[15], 19);
 
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
+  /* Round 1 Operations Finish */
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+  /* Round 2 Operations Start */
 
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  md4Round2Step8(a, b, c, d, words[0], 3);
+  md4Round2Step8(d, a, b, c, words[4], 5);
+  md4Round2Step8(c, d, a, b, words[8], 9);
+  md4Round2Step8(b, c, d, a, words[12], 13);
 
-  /* Fill pad buffer */
+  md4Round2Step8(a, b, c, d, words[1], 3);
+  md4Round2Step8(d, a, b, c, words[5], 5);
+  md4Round2Step8(c, d, a, b, words[9], 9);
+  md4Round2Step8(b, c, d, a, words[13], 13);
 
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+  md4Round2Step8(a, b, c, d, words[2], 3);
+  md4Round2Step8(d, a, b, c, words[6], 5);
+  md4Round2Step8(c, d, a, b, words[10], 9);
+  md4Round2Step8(b, c, d, a, words[14], 13);
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  md4Round2Step8(a, b, c, d, words[3], 3);
+  md4Round2Step8(d, a, b, c, words[7], 5);
+  md4Round2Step8(c, d, a, b, words[11], 9);
+  md4Round2Step8(b, c, d, a, words[15], 13);
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+  /* Round 2 Operations Finish */
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+  /* Round 3 Operations Start */
 
-  padPos = padLength - 1;
+  md4Round3Step8(a, b, c, d, words[0], 3);
+  md4Round3Step8(d, a, b, c, words[8], 9);
+  md4Round3Step8(c, d, a, b, words[4], 11);
+  md4Round3Step8(b, c, d, a, words[12], 15);
 
-  uint64_t val = lengthHolder;
-  uint64_t temp = 0;
+  md4Round3Step8(a, b, c, d, words[2], 3);
+  md4Round3Step8(d, a, b, c, words[10], 9);
+  md4Round3Step8(c, d, a, b, words[6], 11);
+  md4Round3Step8(b, c, d, a, words[14], 15);
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 63; ++bitPos) {
-    bool bit = val & (1l << bitPos);
+  md4Round3Step8(a, b, c, d, words[1], 3);
+  md4Round3Step8(d, a, b, c, words[9], 9);
+  md4Round3Step8(c, d, a, b, words[5], 11);
+  md4Round3Step8(b, c, d, a, words[13], 15);
 
-    padBuffer[padPos] = bit;
+  md4Round3Step8(a, b, c, d, words[3], 3);
+  md4Round3Step8(d, a, b, c, words[11], 9);
+  md4Round3Step8(c, d, a, b, words[7], 11);
+  md4Round3Step8(b, c, d, a, words[15], 15);
 
-    if(bit) {
-      temp += 1l << bitPos;
-      if(temp == val)
-        break;
-    }
+  /* Round 3 Operations Finish */
 
-    --padPos;
-  }
+  // Add the processed registers onto the saved register state
+  _mm256_store_si256((__m256i *)state[0], _mm256_add_epi32(registers[0], a));
+  _mm256_store_si256((__m256i *)state[1], _mm256_add_epi32(registers[1], b));
+  _mm256_store_si256((__m256i *)state[2], _mm256_add_epi32(registers[2], c));
+  _mm256_store_si256((__m256i *)state[3], _mm256_add_epi32(registers[3], d));
+}
 
-  // Create constants array and initial state registers
-  uint32_t constants[80];
-  uint32_t stateRegisters[5];
-
-  // Fill constants array
-  for(short count = 0; count < 80; ++count)
-    if(count < 20)
-      constants[count] = 1518500249;    // 0x5a827999
-    else if(count >= 20 && count < 40)
-      constants[count] = 1859775393;    // 0x6ed9eba1
-    else if(count >= 30 && count < 60)
-      constants[count] = 2400959708;    // 0x8f1bbcdc
-    else
-      constants[count] = 3395469782;    // 0xca62c1d6
+#endif
 
-  // Fill initial state registers
-  for(short count = 0; count < 5; ++count)
-    switch(count) {
-      case 0:
-        stateRegisters[count] = 1732584193;  // 0x67452301
-        break;
+const uint32_t md4StartingState[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
 
-      case 1:
-        stateRegisters[count] = 4023233417;  // 0xefcdab89
-        break;
+const Md4Traits::Word *Md4Traits::startingState() {
+  return md4StartingState;
+}
 
-      case 2:
-        stateRegisters[count] = 2562383102;  // 0x98badcfe
-        break;
+void Md4Traits::processBlock(const uint8_t block[], Word registers[]) {
+  md4processBlock(block, registers);
+}
 
-      case 3:
-        stateRegisters[count] = 271733878;   // 0x10325476
-        break;
+template class MerkleDamgardCtx<Md4Traits>;
 
-      case 4:
-        stateRegisters[count] = 3285377520;  // 0xc3d2e1f0
-    }
+string md4(const void *data, size_t length) {
+  Md4Ctx ctx;
+  ctx.update(data, length);
 
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
+  return ctx.finalize();
+}
 
-  int blockTrack = 0;
-  uint32_t registerStateSave[5];
+string md4(string_view data) {
+  return md4(data.data(), data.length());
+}
 
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
+Digest<16> md4Digest(const void *data, size_t length) {
+  Md4Ctx ctx;
+  ctx.update(data, length);
 
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for (uint32_t val: stateRegisters)
-        registerStateSave[pos++] = val;
+  return ctx.finalizeDigest();
+}
 
-      sha1processBlock(block, stateRegisters, constants);
+Digest<16> md4Digest(string_view data) {
+  return md4Digest(data.data(), data.length());
+}
 
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 5; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
+/*
+  Hashes every message of a batch, 8 at a time with AVX2 or otherwise one
+  after another
+*/
+vector<Digest<16>> md4Batch(const string_view data[], size_t count) {
+  vector<Digest<16>> digests(count);
+
+  auto store = [&digests](size_t message, const uint32_t registers[]) {
+    for(short pos = 0; pos < 4; ++pos)
+      storeLittleEndian32(digests[message].data() + pos * 4, registers[pos]);
+  };
+
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2 && calibratedBatchLanes(batchMd4, data, count) != 1) {
+    hashBatch<uint32_t, 8, 4, 64, 8, false>(data, count, md4StartingState,
+                                            md4processBlocks8AVX2, store);
+    return digests;
+  }
+#endif
 
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+  auto kernel = [](const uint8_t *blocks[], uint32_t state[][1]) {
+    uint32_t registers[4];
+    for(short pos = 0; pos < 4; ++pos)
+      registers[pos] = state[pos][0];
 
-        uint32_t newStateVal = tempVal % 4294967296;
+    md4processBlock(blocks[0], registers);
 
-        stateRegisters[pointer] = newStateVal;
+    for(short pos = 0; pos < 4; ++pos)
+      state[pos][0] = registers[pos];
+  };
 
-        tempVal = 0;
-      }
+  hashBatch<uint32_t, 1, 4, 64, 8, false>(data, count, md4StartingState, kernel, store);
+  return digests;
+}
 
-      blockTrack = 0;
-    }
-  }
+vector<Digest<16>> md4Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-  return hexDigest(stateRegisters, 5);
+  return md4Batch(views.data(), views.size());
 }
 
 /*---------------------------------------------------------------------------*/
-/*                           Begin SHA256 Section                            */
+/*                             Begin MD5 Section                             */
 /*---------------------------------------------------------------------------*/
 
 /*
-  SHA256 Algorithm designed using the specifications described in
+  MD5 Algorithm designed using the specifications described in
 
-  NIST FIPS Publication 180-4
+  RFC 1321
 
-  published in August 2015
+  Published in April 1992
 */
 
+// Additive constants (T table in RFC 1321), holding the integer part of
+// abs(sin(i)) * 2^32 for i = 1 through 64
+const uint32_t md5Constants[64] = {0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+                                  0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+                                  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+                                  0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+                                  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+                                  0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+                                  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+                                  0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+                                  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+                                  0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+                                  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+                                  0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+                                  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+                                  0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+                                  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+                                  0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
 /*
-  The lower sigma 0 (σ0) function for SHA224 and SHA256, defined as follows:
+  Single operations of each of the four rounds, defined as follows:
 
-  Given a 32 bit number, create another 32 bit number by performing the following
+  A = B + rotationalLeftShift((A + F(B, C, D) + blockWord + constant), shift)
 
-  Rotational Right Shift of 7 bits from the original number XORd with
-  Rotational Right Shift of 18 bits from the original number XORd with
-  Right Shift of 3 bits from the original number
+  With F being oldChoice, choiceVariant, parity and weirdChoiceVariant for
+  rounds 1 through 4 respectively. All additions are taken modulo 2^32
+  through unsigned overflow.
 */
-void lowerSigma0_256(bool word[32], uint32_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 7 times
-  bool tempWord1[32];
-  rotationalRightShift(tempWord1, val, 7);
-
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 18 times
-  bool tempWord2[32];
-  rotationalRightShift(tempWord2, val, 18);
-
-  // Temp word 3 is the result of a right shift of 3
-  bool tempWord3[32];
-  uint32_t tempVal = val >> 3;
-  short wordPos = 0;
-  for(short bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = tempVal & (1l << bitPos);
-
-    tempWord3[wordPos++] = bit;
-  }
+inline void md5Round1Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          uint32_t constant, unsigned int shift) {
+  a = b + rotationalLeftShift(a + oldChoice(b, c, d) + word + constant, shift);
+}
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 32; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
+inline void md5Round2Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          uint32_t constant, unsigned int shift) {
+  a = b + rotationalLeftShift(a + choiceVariant(b, c, d) + word + constant, shift);
 }
 
-/*
-  The lower sigma 1 (σ1) function for SHA224 and SHA256, defined as follows:
+inline void md5Round3Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          uint32_t constant, unsigned int shift) {
+  a = b + rotationalLeftShift(a + parity(b, c, d) + word + constant, shift);
+}
 
-  Given a 32 bit number, create another 32 bit number by performing the following
+inline void md5Round4Step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t word,
+                          uint32_t constant, unsigned int shift) {
+  a = b + rotationalLeftShift(a + weirdChoiceVariant(b, c, d) + word + constant, shift);
+}
 
-  Rotational Right Shift of 17 bits from the original number XORd with
-  Rotational Right Shift of 19 bits from the original number XORd with
-  Right Shift of 10 bits from the original number
-*/
-void lowerSigma1_256(bool word[32], uint32_t val) {\
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 17 times
-  bool tempWord1[32];
-  rotationalRightShift(tempWord1, val, 17);
-
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 19 times
-  bool tempWord2[32];
-  rotationalRightShift(tempWord2, val, 19);
-
-  // Temp word 3 is the result of a right shift of 10
-  bool tempWord3[32];
-  uint32_t tempVal = val >> 10;
-  short wordPos = 0;
-  for(short bitPos = 31; bitPos >= 0; --bitPos) {
-    bool bit = tempVal & (1l << bitPos);
-
-    tempWord3[wordPos++] = bit;
-  }
+void md5processBlock(const uint8_t block[64], uint32_t stateRegisters[4]) {
+  // Translate block into an array of 16 32 bit words using little endian
+  // convention
+  uint32_t wordArray[16];
+  for(short wordTrack = 0; wordTrack < 16; ++wordTrack)
+    wordArray[wordTrack] = loadLittleEndian32(block + wordTrack * 4);
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 32; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
-}
+  uint32_t a = stateRegisters[0];
+  uint32_t b = stateRegisters[1];
+  uint32_t c = stateRegisters[2];
+  uint32_t d = stateRegisters[3];
 
-/*
-  The upper sigma 0 (Σ0) function for SHA224 and SHA256, defined as follows:
+  /* Round 1 Operations Start */
 
-  Given a 32 bit number, create another 32 bit number by performing the following
+  md5Round1Step(a, b, c, d, wordArray[0], md5Constants[0], 7);
+  md5Round1Step(d, a, b, c, wordArray[1], md5Constants[1], 12);
+  md5Round1Step(c, d, a, b, wordArray[2], md5Constants[2], 17);
+  md5Round1Step(b, c, d, a, wordArray[3], md5Constants[3], 22);
 
-  Rotational Right Shift of 2 bits from the original number XORd with
-  Rotational Right Shift of 13 bits from the original number XORd with
-  Rotational Right Shift of 22 bits from the original number
-*/
-void upperSigma0_256(bool word[32], uint32_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 2 times
-  bool tempWord1[32];
-  rotationalRightShift(tempWord1, val, 2);
+  md5Round1Step(a, b, c, d, wordArray[4], md5Constants[4], 7);
+  md5Round1Step(d, a, b, c, wordArray[5], md5Constants[5], 12);
+  md5Round1Step(c, d, a, b, wordArray[6], md5Constants[6], 17);
+  md5Round1Step(b, c, d, a, wordArray[7], md5Constants[7], 22);
 
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 13 times
-  bool tempWord2[32];
-  rotationalRightShift(tempWord2, val, 13);
+  md5Round1Step(a, b, c, d, wordArray[8], md5Constants[8], 7);
+  md5Round1Step(d, a, b, c, wordArray[9], md5Constants[9], 12);
+  md5Round1Step(c, d, a, b, wordArray[10], md5Constants[10], 17);
+  md5Round1Step(b, c, d, a, wordArray[11], md5Constants[11], 22);
 
-  // Temp word 3 is the resulting word from performing a rotational right
-  // shift on originally passed word 22 times
-  bool tempWord3[32];
-  rotationalRightShift(tempWord3, val, 22);
+  md5Round1Step(a, b, c, d, wordArray[12], md5Constants[12], 7);
+  md5Round1Step(d, a, b, c, wordArray[13], md5Constants[13], 12);
+  md5Round1Step(c, d, a, b, wordArray[14], md5Constants[14], 17);
+  md5Round1Step(b, c, d, a, wordArray[15], md5Constants[15], 22);
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 32; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
-}
+  /* Round 1 Operations Finish */
 
-/*
-  The upper sigma 1 (Σ1) function for SHA224 and SHA256, defined as follows:
+  /* Round 2 Operations Start */
 
-  Given a 32 bit number, create another 32 bit number by performing the following
+  md5Round2Step(a, b, c, d, wordArray[1], md5Constants[16], 5);
+  md5Round2Step(d, a, b, c, wordArray[6], md5Constants[17], 9);
+  md5Round2Step(c, d, a, b, wordArray[11], md5Constants[18], 14);
+  md5Round2Step(b, c, d, a, wordArray[0], md5Constants[19], 20);
 
-  Rotational Right Shift of 6 bits from the original number XORd with
-  Rotational Right Shift of 11 bits from the original number XORd with
-  Rotational Right Shift of 25 bits from the original number
-*/
-void upperSigma1_256(bool word[32], uint32_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 6 times
-  bool tempWord1[32];
-  rotationalRightShift(tempWord1, val, 6);
+  md5Round2Step(a, b, c, d, wordArray[5], md5Constants[20], 5);
+  md5Round2Step(d, a, b, c, wordArray[10], md5Constants[21], 9);
+  md5Round2Step(c, d, a, b, wordArray[15], md5Constants[22], 14);
+  md5Round2Step(b, c, d, a, wordArray[4], md5Constants[23], 20);
 
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 11 times
-  bool tempWord2[32];
-  rotationalRightShift(tempWord2, val, 11);
+  md5Round2Step(a, b, c, d, wordArray[9], md5Constants[24], 5);
+  md5Round2Step(d, a, b, c, wordArray[14], md5Constants[25], 9);
+  md5Round2Step(c, d, a, b, wordArray[3], md5Constants[26], 14);
+  md5Round2Step(b, c, d, a, wordArray[8], md5Constants[27], 20);
 
-  // Temp word 3 is the resulting word from performing a rotational right
-  // shift on originally passed word 25 times
-  bool tempWord3[32];
-  rotationalRightShift(tempWord3, val, 25);
+  md5Round2Step(a, b, c, d, wordArray[13], md5Constants[28], 5);
+  md5Round2Step(d, a, b, c, wordArray[2], md5Constants[29], 9);
+  md5Round2Step(c, d, a, b, wordArray[7], md5Constants[30], 14);
+  md5Round2Step(b, c, d, a, wordArray[12], md5Constants[31], 20);
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 32; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
-}
+  /* Round 2 Operations Finish */
 
-// Message schedule generation function used by SHA224 and SHA256
-void generateSchedule256(bool block[512], uint32_t schedule[64]) {
-  // Create the first 16 32-bit words using the message block
-  short bitCount = 0;
-  short schedulePos = 0;
-  short bitPos = 31;
-  bool word[32];
-  for(int blockCount = 0; blockCount < 512; ++blockCount) {
-    word[bitCount] = block[blockCount];
-    ++bitCount;
-
-    if(bitCount == 32) {
-      uint32_t val = 0;
-
-      for (bool wordBit: word) {
-        if (wordBit)
-          val += 1 << bitPos;
-        --bitPos;
-      }
+  /* Round 3 Operations Start */
 
-      schedule[schedulePos] = val;
-      ++schedulePos;
+  md5Round3Step(a, b, c, d, wordArray[5], md5Constants[32], 4);
+  md5Round3Step(d, a, b, c, wordArray[8], md5Constants[33], 11);
+  md5Round3Step(c, d, a, b, wordArray[11], md5Constants[34], 16);
+  md5Round3Step(b, c, d, a, wordArray[14], md5Constants[35], 23);
 
-      bitCount = 0;
-      bitPos = 31;
-    }
-  }
+  md5Round3Step(a, b, c, d, wordArray[1], md5Constants[36], 4);
+  md5Round3Step(d, a, b, c, wordArray[4], md5Constants[37], 11);
+  md5Round3Step(c, d, a, b, wordArray[7], md5Constants[38], 16);
+  md5Round3Step(b, c, d, a, wordArray[10], md5Constants[39], 23);
 
-  // Expand the schedule to 64 32-bit words
-  while(schedulePos < 64) {
-    bool word1[32];
-    lowerSigma0_256(word1, schedule[schedulePos - 15]);
-
-    bool word2[32];
-    lowerSigma1_256(word2, schedule[schedulePos - 2]);
-
-    short wordPos = 0;
-    bool word3[32];
-    uint32_t val = schedule[schedulePos - 7];
-    while (bitPos >= 0) {
-      word3[wordPos] = val & (1l << bitPos);
-      ++wordPos;
-      --bitPos;
-    }
+  md5Round3Step(a, b, c, d, wordArray[13], md5Constants[40], 4);
+  md5Round3Step(d, a, b, c, wordArray[0], md5Constants[41], 11);
+  md5Round3Step(c, d, a, b, wordArray[3], md5Constants[42], 16);
+  md5Round3Step(b, c, d, a, wordArray[6], md5Constants[43], 23);
 
-    bitPos = 31;
-    wordPos = 0;
-    bool word4[32];
-    val = schedule[schedulePos - 16];
-    while (bitPos >= 0) {
-      word4[wordPos] = val & (1l << bitPos);
-      ++wordPos;
-      --bitPos;
-    }
+  md5Round3Step(a, b, c, d, wordArray[9], md5Constants[44], 4);
+  md5Round3Step(d, a, b, c, wordArray[12], md5Constants[45], 11);
+  md5Round3Step(c, d, a, b, wordArray[15], md5Constants[46], 16);
+  md5Round3Step(b, c, d, a, wordArray[2], md5Constants[47], 23);
 
-    bitPos = 31;
+  /* Round 3 Operations Finish */
 
-    // Add them all and take the result mod 2^32
-    unsigned long tempValue = 0;
-    short bitTrack = 0;
-    for (short bitPos = 31; bitPos >= 0; --bitPos) {
-      if (word1[bitPos])
-        tempValue += 1l << bitTrack;
+  /* Round 4 Operations Start */
 
-      if(word2[bitPos])
-        tempValue += 1l << bitTrack;
+  md5Round4Step(a, b, c, d, wordArray[0], md5Constants[48], 6);
+  md5Round4Step(d, a, b, c, wordArray[7], md5Constants[49], 10);
+  md5Round4Step(c, d, a, b, wordArray[14], md5Constants[50], 15);
+  md5Round4Step(b, c, d, a, wordArray[5], md5Constants[51], 21);
 
-      if(word3[bitPos])
-        tempValue += 1l << bitTrack;
+  md5Round4Step(a, b, c, d, wordArray[12], md5Constants[52], 6);
+  md5Round4Step(d, a, b, c, wordArray[3], md5Constants[53], 10);
+  md5Round4Step(c, d, a, b, wordArray[10], md5Constants[54], 15);
+  md5Round4Step(b, c, d, a, wordArray[1], md5Constants[55], 21);
 
-      if(word4[bitPos])
-        tempValue += 1l << bitTrack;
+  md5Round4Step(a, b, c, d, wordArray[8], md5Constants[56], 6);
+  md5Round4Step(d, a, b, c, wordArray[15], md5Constants[57], 10);
+  md5Round4Step(c, d, a, b, wordArray[6], md5Constants[58], 15);
+  md5Round4Step(b, c, d, a, wordArray[13], md5Constants[59], 21);
 
-      ++bitTrack;
-    }
+  md5Round4Step(a, b, c, d, wordArray[4], md5Constants[60], 6);
+  md5Round4Step(d, a, b, c, wordArray[11], md5Constants[61], 10);
+  md5Round4Step(c, d, a, b, wordArray[2], md5Constants[62], 15);
+  md5Round4Step(b, c, d, a, wordArray[9], md5Constants[63], 21);
 
-    uint32_t scheduleWord = tempValue % 4294967296;
+  /* Round 4 Operations Finish */
 
-    schedule[schedulePos] = scheduleWord;
-    ++schedulePos;
-  }
+  // Add the processed registers onto the saved register state
+  stateRegisters[0] += a;
+  stateRegisters[1] += b;
+  stateRegisters[2] += c;
+  stateRegisters[3] += d;
 }
 
-void generateStartingHashState256(uint32_t constArray[64], uint32_t registers[8]) {
-  union {
-    double input;
-    uint64_t output;
-  } data;
+#if defined(__x86_64__) || defined(__i386__)
 
-  // Generates the first 64 primes and uses the fractional bits of the cube
-  // roots of these primes to create our constants and the fractional portion
-  // of their square roots for the starting states of the registers
+/*
+  Multi-buffer MD5, running one block from each of 8 independent messages
+  side by side, one message per 32 bit lane. The steps mirror the ones above
+  with every register holding the same word of all 8 lanes.
+*/
+__attribute__((target("avx2")))
+inline void md5Round1Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word,
+                           __m256i constant, int shift) {
+  __m256i mix = _mm256_xor_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d));
+  a = _mm256_add_epi32(b, rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                                                   _mm256_add_epi32(word, constant)), shift));
+}
 
-  // Calculate cube root of 2 and retrieve the constant
-  data.input = cbrt(2.0);
+__attribute__((target("avx2")))
+inline void md5Round2Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word,
+                           __m256i constant, int shift) {
+  __m256i mix = _mm256_or_si256(_mm256_and_si256(b, d), _mm256_andnot_si256(d, c));
+  a = _mm256_add_epi32(b, rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                                                   _mm256_add_epi32(word, constant)), shift));
+}
 
-  bitset<sizeof(double) * CHAR_BIT> bits(data.output);
+__attribute__((target("avx2")))
+inline void md5Round3Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word,
+                           __m256i constant, int shift) {
+  __m256i mix = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  a = _mm256_add_epi32(b, rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                                                   _mm256_add_epi32(word, constant)), shift));
+}
 
-  uint32_t val = 0;
-  int pos = 31;
-  for(int bitPos = 51; bitPos > 19; --bitPos) {
-    if (bits[bitPos] == 1)
-      val += 1l << pos;
+__attribute__((target("avx2")))
+inline void md5Round4Step8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i word,
+                           __m256i constant, int shift) {
+  __m256i mix = _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, _mm256_set1_epi32(-1))));
+  a = _mm256_add_epi32(b, rotationalLeftShift8x32(_mm256_add_epi32(_mm256_add_epi32(a, mix),
+                                                                   _mm256_add_epi32(word, constant)), shift));
+}
 
-    --pos;
-  }
+__attribute__((target("avx2")))
+void md5processBlocks8AVX2(const uint8_t *blocks[8], uint32_t state[4][8]) {
+  __m256i words[16];
+  loadWords8x32(blocks, words, false);
 
-  constArray[0] = val;
+  __m256i registers[4];
+  for(short pos = 0; pos < 4; ++pos)
+    registers[pos] = _mm256_load_si256((const __m256i *)state[pos]);
 
-  // Calculate square root of 2 and retrieve register 0
-  data.input = sqrt(2.0);
+  __m256i a = registers[0];
+  __m256i b = registers[1];
+  __m256i c = registers[2];
+  __m256i d = registers[3];
 
-  bitset<sizeof(double) * CHAR_BIT> bits2(data.output);
+  /* Round 1 Operations Start */
 
-  val = 0;
-  pos = 31;
-  for(int bitPos = 51; bitPos > 19; --bitPos) {
-    if (bits2[bitPos] == 1)
-      val += 1l << pos;
+  md5Round1Step8(a, b, c, d, words[0], _mm256_set1_epi32(md5Constants[0]), 7);
+  md5Round1Step8(d, a, b, c, words[1], _mm256_set1_epi32(md5Constants[1]), 12);
+  md5Round1Step8(c, d, a, b, words[2], _mm256_set1_epi32(md5Constants[2]), 17);
+  md5Round1Step8(b, c, d, a, words[3], _mm256_set1_epi32(md5Constants[3]), 22);
 
-    --pos;
-  }
+  md5Round1Step8(a, b, c, d, words[4], _mm256_set1_epi32(md5Constants[4]), 7);
+  md5Round1Step8(d, a, b, c, words[5], _mm256_set1_epi32(md5Constants[5]), 12);
+  md5Round1Step8(c, d, a, b, words[6], _mm256_set1_epi32(md5Constants[6]), 17);
+  md5Round1Step8(b, c, d, a, words[7], _mm256_set1_epi32(md5Constants[7]), 22);
 
-  registers[0] = val;
+  md5Round1Step8(a, b, c, d, words[8], _mm256_set1_epi32(md5Constants[8]), 7);
+  md5Round1Step8(d, a, b, c, words[9], _mm256_set1_epi32(md5Constants[9]), 12);
+  md5Round1Step8(c, d, a, b, words[10], _mm256_set1_epi32(md5Constants[10]), 17);
+  md5Round1Step8(b, c, d, a, words[11], _mm256_set1_epi32(md5Constants[11]), 22);
 
-  // Calculate the remaining 63 primes and their resulting constants and
-  // starting registers states
-  int tracker = 3;
-  int counter;
-  int num;
-  int constArrPos = 1;
-  int registerTrack = 1;
+  md5Round1Step8(a, b, c, d, words[12], _mm256_set1_epi32(md5Constants[12]), 7);
+  md5Round1Step8(d, a, b, c, words[13], _mm256_set1_epi32(md5Constants[13]), 12);
+  md5Round1Step8(c, d, a, b, words[14], _mm256_set1_epi32(md5Constants[14]), 17);
+  md5Round1Step8(b, c, d, a, words[15], _mm256_set1_epi32(md5Constants[15]), 22);
 
-  for(counter = 2; counter <= 64; ++tracker) {
-    for(num = 2; num < tracker; ++num)
-      if(tracker % num == 0)
-        break;
+  /* Round 1 Operations Finish */
 
-    if(num == tracker) {
-      // Next prime found
-      pos = 31;
-      data.input = cbrt((double)tracker);
-
-      bitset<sizeof(double) * CHAR_BIT> bits(data.output);
-
-      // Account for shifting bits as the integral portion
-      // (left of the decimal point) starts surpassing powers
-      // of 2
-      double temp;
-      modf(data.input, &temp);
-      int tempInt = (int)temp;
-      int expShift = 0;
-      while(tempInt > 1 << expShift) {
-        tempInt -= 1l << expShift;
-        ++expShift;
-      }
+  /* Round 2 Operations Start */
 
-      val = 0;
-      for(int bitPos = 51 - expShift; bitPos > 19 - expShift; --bitPos) {
-        if (bits[bitPos] == 1)
-          val += 1ul << pos;
+  md5Round2Step8(a, b, c, d, words[1], _mm256_set1_epi32(md5Constants[16]), 5);
+  md5Round2Step8(d, a, b, c, words[6], _mm256_set1_epi32(md5Constants[17]), 9);
+  md5Round2Step8(c, d, a, b, words[11], _mm256_set1_epi32(md5Constants[18]), 14);
+  md5Round2Step8(b, c, d, a, words[0], _mm256_set1_epi32(md5Constants[19]), 20);
 
-        --pos;
-      }
+  md5Round2Step8(a, b, c, d, words[5], _mm256_set1_epi32(md5Constants[20]), 5);
+  md5Round2Step8(d, a, b, c, words[10], _mm256_set1_epi32(md5Constants[21]), 9);
+  md5Round2Step8(c, d, a, b, words[15], _mm256_set1_epi32(md5Constants[22]), 14);
+  md5Round2Step8(b, c, d, a, words[4], _mm256_set1_epi32(md5Constants[23]), 20);
 
-      constArray[constArrPos] = val;
-      ++constArrPos;
+  md5Round2Step8(a, b, c, d, words[9], _mm256_set1_epi32(md5Constants[24]), 5);
+  md5Round2Step8(d, a, b, c, words[14], _mm256_set1_epi32(md5Constants[25]), 9);
+  md5Round2Step8(c, d, a, b, words[3], _mm256_set1_epi32(md5Constants[26]), 14);
+  md5Round2Step8(b, c, d, a, words[8], _mm256_set1_epi32(md5Constants[27]), 20);
 
-      if(registerTrack < 8) {
-        // Calculate register state value for current prime
-        pos = 31;
-        data.input = sqrt((double)tracker);
+  md5Round2Step8(a, b, c, d, words[13], _mm256_set1_epi32(md5Constants[28]), 5);
+  md5Round2Step8(d, a, b, c, words[2], _mm256_set1_epi32(md5Constants[29]), 9);
+  md5Round2Step8(c, d, a, b, words[7], _mm256_set1_epi32(md5Constants[30]), 14);
+  md5Round2Step8(b, c, d, a, words[12], _mm256_set1_epi32(md5Constants[31]), 20);
 
-        bitset<sizeof(double) * CHAR_BIT> bits(data.output);
+  /* Round 2 Operations Finish */
 
-        modf(data.input, &temp);
-        tempInt = (int)temp;
-        expShift = 0;
-        while(tempInt > 1l << expShift) {
-          tempInt -= 1l << expShift;
-          ++expShift;
-        }
+  /* Round 3 Operations Start */
 
-        val = 0;
-        for(int bitPos = 51 - expShift; bitPos > 19 - expShift; --bitPos) {
-          if (bits[bitPos] == 1)
-            val += 1l << pos;
+  md5Round3Step8(a, b, c, d, words[5], _mm256_set1_epi32(md5Constants[32]), 4);
+  md5Round3Step8(d, a, b, c, words[8], _mm256_set1_epi32(md5Constants[33]), 11);
+  md5Round3Step8(c, d, a, b, words[11], _mm256_set1_epi32(md5Constants[34]), 16);
+  md5Round3Step8(b, c, d, a, words[14], _mm256_set1_epi32(md5Constants[35]), 23);
 
-          --pos;
-        }
+  md5Round3Step8(a, b, c, d, words[1], _mm256_set1_epi32(md5Constants[36]), 4);
+  md5Round3Step8(d, a, b, c, words[4], _mm256_set1_epi32(md5Constants[37]), 11);
+  md5Round3Step8(c, d, a, b, words[7], _mm256_set1_epi32(md5Constants[38]), 16);
+  md5Round3Step8(b, c, d, a, words[10], _mm256_set1_epi32(md5Constants[39]), 23);
 
-        registers[registerTrack] = val;
-        ++registerTrack;
-      }
+  md5Round3Step8(a, b, c, d, words[13], _mm256_set1_epi32(md5Constants[40]), 4);
+  md5Round3Step8(d, a, b, c, words[0], _mm256_set1_epi32(md5Constants[41]), 11);
+  md5Round3Step8(c, d, a, b, words[3], _mm256_set1_epi32(md5Constants[42]), 16);
+  md5Round3Step8(b, c, d, a, words[6], _mm256_set1_epi32(md5Constants[43]), 23);
 
-      ++counter;
-    }
-  }
-}
+  md5Round3Step8(a, b, c, d, words[9], _mm256_set1_epi32(md5Constants[44]), 4);
+  md5Round3Step8(d, a, b, c, words[12], _mm256_set1_epi32(md5Constants[45]), 11);
+  md5Round3Step8(c, d, a, b, words[15], _mm256_set1_epi32(md5Constants[46]), 16);
+  md5Round3Step8(b, c, d, a, words[2], _mm256_set1_epi32(md5Constants[47]), 23);
 
-void sha256processBlock(bool block[512], uint32_t registers[8], uint32_t constants[64]) {
-  /* Create message schedule */
-  uint32_t schedule[64];
+  /* Round 3 Operations Finish */
 
-  generateSchedule256(block, schedule);
+  /* Round 4 Operations Start */
 
-  /* Begin compression process */
-  for(short word = 0; word < 64; ++word) {
-    uint32_t scheduleWord = schedule[word];
-    uint32_t constantWord = constants[word];
-
-    /* Create first temporary word used to change state registers */
-
-    // Generate first temporary word using the resulting word from passing
-    // the word in the 5th register to the upper sigma 1 function
-    bool tempWord1[32];
-    upperSigma1_256(tempWord1, registers[4]);
-
-    // Generate second temporary word using the resulting word from passing
-    // the 5th, 6th and 7th registers to the choice function
-    bool tempWord2[32];
-    choice(tempWord2, registers[4], registers[5], registers[6]);
-
-    // Temp word 3 is simply the 8th register, temp word 4 is the schedule word
-    // and temp word 5 is the constant word
-    uint32_t val = registers[7];
-    bool tempWord3[32];
-    bool tempWord4[32];
-    bool tempWord5[32];
-    short wordPos = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      tempWord3[bitPos] = val & (1l << wordPos);
-      tempWord4[bitPos] = scheduleWord & (1l << wordPos);
-      tempWord5[bitPos] = constantWord & (1l << wordPos);
-
-      ++wordPos;
-    }
+  md5Round4Step8(a, b, c, d, words[0], _mm256_set1_epi32(md5Constants[48]), 6);
+  md5Round4Step8(d, a, b, c, words[7], _mm256_set1_epi32(md5Constants[49]), 10);
+  md5Round4Step8(c, d, a, b, words[14], _mm256_set1_epi32(md5Constants[50]), 15);
+  md5Round4Step8(b, c, d, a, words[5], _mm256_set1_epi32(md5Constants[51]), 21);
 
-    // Add all words up taken at module 2^32 to get the first final temp word
-    unsigned long finTempVal = 0;
+  md5Round4Step8(a, b, c, d, words[12], _mm256_set1_epi32(md5Constants[52]), 6);
+  md5Round4Step8(d, a, b, c, words[3], _mm256_set1_epi32(md5Constants[53]), 10);
+  md5Round4Step8(c, d, a, b, words[10], _mm256_set1_epi32(md5Constants[54]), 15);
+  md5Round4Step8(b, c, d, a, words[1], _mm256_set1_epi32(md5Constants[55]), 21);
 
-    int bitTrack = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      if(tempWord1[bitPos])
-        finTempVal += 1l << bitTrack;
+  md5Round4Step8(a, b, c, d, words[8], _mm256_set1_epi32(md5Constants[56]), 6);
+  md5Round4Step8(d, a, b, c, words[15], _mm256_set1_epi32(md5Constants[57]), 10);
+  md5Round4Step8(c, d, a, b, words[6], _mm256_set1_epi32(md5Constants[58]), 15);
+  md5Round4Step8(b, c, d, a, words[13], _mm256_set1_epi32(md5Constants[59]), 21);
 
-      if(tempWord2[bitPos])
-        finTempVal += 1l << bitTrack;
+  md5Round4Step8(a, b, c, d, words[4], _mm256_set1_epi32(md5Constants[60]), 6);
+  md5Round4Step8(d, a, b, c, words[11], _mm256_set1_epi32(md5Constants[61]), 10);
+  md5Round4Step8(c, d, a, b, words[2], _mm256_set1_epi32(md5Constants[62]), 15);
+  md5Round4Step8(b, c, d, a, words[9], _mm256_set1_epi32(md5Constants[63]), 21);
 
-      if(tempWord3[bitPos])
-        finTempVal += 1l << bitTrack;
+  /* Round 4 Operations Finish */
 
-      if(tempWord4[bitPos])
-        finTempVal += 1l << bitTrack;
+  // Add the processed registers onto the saved register state
+  _mm256_store_si256((__m256i *)state[0], _mm256_add_epi32(registers[0], a));
+  _mm256_store_si256((__m256i *)state[1], _mm256_add_epi32(registers[1], b));
+  _mm256_store_si256((__m256i *)state[2], _mm256_add_epi32(registers[2], c));
+  _mm256_store_si256((__m256i *)state[3], _mm256_add_epi32(registers[3], d));
+}
 
-      if(tempWord5[bitPos])
-        finTempVal += 1l << bitTrack;
+#endif
 
-      ++bitTrack;
-    }
+const uint32_t md5StartingState[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
 
-    uint32_t finalTemp1 = finTempVal % 4294967296;
+const Md5Traits::Word *Md5Traits::startingState() {
+  return md5StartingState;
+}
 
-    /* Create second temporary word used to change state registers */
+void Md5Traits::processBlock(const uint8_t block[], Word registers[]) {
+  md5processBlock(block, registers);
+}
 
-    // Generate first temporary word using the resulting word from passing
-    // the word in the first register to the upper sigma 0 function
-    upperSigma0_256(tempWord1, registers[0]);
-    unsigned long val1 = 0;
-    bitTrack = 31;
-    for(bool bit: tempWord1) {
-      if(bit)
-        val1 += 1l << bitTrack;
-      --bitTrack;
-    }
+template class MerkleDamgardCtx<Md5Traits>;
 
-    // Generate second temporary word using the resulting word from passing
-    // the 1st, 2nd and 3rd registers to the majority function
-    majority(tempWord2, registers[0], registers[1], registers[2]);
-    unsigned long val2 = 0;
-    bitTrack = 31;
-    for(bool bit: tempWord2) {
-      if(bit)
-        val2 += 1l << bitTrack;
-      --bitTrack;
-    }
+string md5(const void *data, size_t length) {
+  Md5Ctx ctx;
+  ctx.update(data, length);
 
-    // Add all words up taken at module 2^32 to get the second final temp word
-    finTempVal = val1 + val2;
+  return ctx.finalize();
+}
 
-    uint32_t finalTemp2 = finTempVal % 4294967296;
+string md5(string_view data) {
+  return md5(data.data(), data.length());
+}
 
-    /* Update state registers */
+Digest<16> md5Digest(const void *data, size_t length) {
+  Md5Ctx ctx;
+  ctx.update(data, length);
 
-    // Shift register values to the right, discarding the value held in
-    // register 8
-    for(int iter = 7; iter > 0; --iter)
-      registers[iter] = registers[iter - 1];
+  return ctx.finalizeDigest();
+}
 
-    // Fill first register position with the result of adding together the two
-    // temporary words generated above taken modulo 2^32
-    finTempVal = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      if(finalTemp1 & (1 << bitPos))
-        finTempVal += 1l << bitPos;
+Digest<16> md5Digest(string_view data) {
+  return md5Digest(data.data(), data.length());
+}
 
-      if(finalTemp2 & (1 << bitPos))
-        finTempVal += 1l << bitPos;
-    }
+/*
+  Hashes every message of a batch, 8 at a time with AVX2 or otherwise one
+  after another. Messages of different lengths simply finish in different
+  calls of the kernel, after which their lanes are refilled or left idle.
+*/
+vector<Digest<16>> md5Batch(const string_view data[], size_t count) {
+  vector<Digest<16>> digests(count);
+
+  auto store = [&digests](size_t message, const uint32_t registers[]) {
+    for(short pos = 0; pos < 4; ++pos)
+      storeLittleEndian32(digests[message].data() + pos * 4, registers[pos]);
+  };
+
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2 && calibratedBatchLanes(batchMd5, data, count) != 1) {
+    hashBatch<uint32_t, 8, 4, 64, 8, false>(data, count, md5StartingState,
+                                            md5processBlocks8AVX2, store);
+    return digests;
+  }
+#endif
 
-    uint32_t finalWord = finTempVal % 4294967296;
+  auto kernel = [](const uint8_t *blocks[], uint32_t state[][1]) {
+    uint32_t registers[4];
+    for(short pos = 0; pos < 4; ++pos)
+      registers[pos] = state[pos][0];
 
-    registers[0] = finalWord;
+    md5processBlock(blocks[0], registers);
 
-    // Switch register 5's value with the resulting word from adding together
-    // the 5th register value and the value of the first final temporary word
-    // generated above taken modulo 2^32
-    finTempVal = 0;
-    for(short bitPos = 31; bitPos >= 0; --bitPos) {
-      if(registers[4] & (1l << bitPos))
-        finTempVal += 1l << bitPos;
+    for(short pos = 0; pos < 4; ++pos)
+      state[pos][0] = registers[pos];
+  };
 
-      if(finalTemp1 & (1 << bitPos))
-        finTempVal += 1l << bitPos;
-    }
+  hashBatch<uint32_t, 1, 4, 64, 8, false>(data, count, md5StartingState, kernel, store);
+  return digests;
+}
+
+vector<Digest<16>> md5Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
+
+  return md5Batch(views.data(), views.size());
+}
+
+/*---------------------------------------------------------------------------*/
+/*                            Begin SHA0 Section                             */
+/*---------------------------------------------------------------------------*/
 
-    finalWord = finTempVal % 4294967296;
+/*
+  SHA0 Algorithm designed using the specifications described in
+
+  NIST FIPS Pub 180
+
+  Published in May 1993
+*/
+
+/*
+  Expands the next message schedule word in place. Only the last 16 words
+  are kept, in a circular buffer indexed by the round number.
+
+  SHA1 differs from SHA0 only by rotating each expanded word left by 1 bit,
+  so SHA0 passes a rotation of 0.
+*/
+inline uint32_t expandScheduleSHA1(uint32_t schedule[16], short round, unsigned int scheduleRotation) {
+  uint32_t result = schedule[(round - 3) & 15] ^ schedule[(round - 8) & 15] ^
+                    schedule[(round - 14) & 15] ^ schedule[round & 15];
+
+  return schedule[round & 15] = rotationalLeftShift(result, scheduleRotation);
+}
+
+/*
+  Single operations of each of the four rounds, defined as follows:
+
+  E = E + rotationalLeftShift(A, 5) + F(B, C, D) + scheduleWord + constant
+  B = rotationalLeftShift(B, 30)
+
+  With F being choice, parity, majority and parity for rounds 1 through 4
+  respectively. Instead of shifting every register to the right after each
+  operation, the callers rotate the roles of the registers. All additions are
+  taken modulo 2^32 through unsigned overflow.
+*/
+inline void sha1Round1Step(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e,
+                           uint32_t scheduleWord) {
+  e += rotationalLeftShift(a, 5) + choice(b, c, d) + scheduleWord + 1518500249; // 0x5a827999
+  b = rotationalLeftShift(b, 30);
+}
+
+inline void sha1Round2Step(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e,
+                           uint32_t scheduleWord) {
+  e += rotationalLeftShift(a, 5) + parity(b, c, d) + scheduleWord + 1859775393; // 0x6ed9eba1
+  b = rotationalLeftShift(b, 30);
+}
+
+inline void sha1Round3Step(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e,
+                           uint32_t scheduleWord) {
+  e += rotationalLeftShift(a, 5) + majority(b, c, d) + scheduleWord + 2400959708; // 0x8f1bbcdc
+  b = rotationalLeftShift(b, 30);
+}
+
+inline void sha1Round4Step(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e,
+                           uint32_t scheduleWord) {
+  e += rotationalLeftShift(a, 5) + parity(b, c, d) + scheduleWord + 3395469782; // 0xca62c1d6
+  b = rotationalLeftShift(b, 30);
+}
+
+/*
+  Compression function shared by SHA0 and SHA1
+
+  Used in:
+  - SHA0, SHA1
+*/
+inline void sha1compressBlock(const uint8_t block[64], uint32_t registers[5], unsigned int scheduleRotation) {
+  /* Create the first 16 words of the message schedule */
+  uint32_t schedule[16];
+  for(short schedulePos = 0; schedulePos < 16; ++schedulePos)
+    schedule[schedulePos] = loadBigEndian32(block + schedulePos * 4);
+
+  uint32_t a = registers[0];
+  uint32_t b = registers[1];
+  uint32_t c = registers[2];
+  uint32_t d = registers[3];
+  uint32_t e = registers[4];
+
+  /* Round 1 Operations Start */
+
+  sha1Round1Step(a, b, c, d, e, schedule[0]);
+  sha1Round1Step(e, a, b, c, d, schedule[1]);
+  sha1Round1Step(d, e, a, b, c, schedule[2]);
+  sha1Round1Step(c, d, e, a, b, schedule[3]);
+  sha1Round1Step(b, c, d, e, a, schedule[4]);
+
+  sha1Round1Step(a, b, c, d, e, schedule[5]);
+  sha1Round1Step(e, a, b, c, d, schedule[6]);
+  sha1Round1Step(d, e, a, b, c, schedule[7]);
+  sha1Round1Step(c, d, e, a, b, schedule[8]);
+  sha1Round1Step(b, c, d, e, a, schedule[9]);
+
+  sha1Round1Step(a, b, c, d, e, schedule[10]);
+  sha1Round1Step(e, a, b, c, d, schedule[11]);
+  sha1Round1Step(d, e, a, b, c, schedule[12]);
+  sha1Round1Step(c, d, e, a, b, schedule[13]);
+  sha1Round1Step(b, c, d, e, a, schedule[14]);
+
+  sha1Round1Step(a, b, c, d, e, schedule[15]);
+  sha1Round1Step(e, a, b, c, d, expandScheduleSHA1(schedule, 16, scheduleRotation));
+  sha1Round1Step(d, e, a, b, c, expandScheduleSHA1(schedule, 17, scheduleRotation));
+  sha1Round1Step(c, d, e, a, b, expandScheduleSHA1(schedule, 18, scheduleRotation));
+  sha1Round1Step(b, c, d, e, a, expandScheduleSHA1(schedule, 19, scheduleRotation));
+
+  /* Round 1 Operations Finish */
+
+  /* Round 2 Operations Start */
 
-    registers[4] = finalWord;
+  sha1Round2Step(a, b, c, d, e, expandScheduleSHA1(schedule, 20, scheduleRotation));
+  sha1Round2Step(e, a, b, c, d, expandScheduleSHA1(schedule, 21, scheduleRotation));
+  sha1Round2Step(d, e, a, b, c, expandScheduleSHA1(schedule, 22, scheduleRotation));
+  sha1Round2Step(c, d, e, a, b, expandScheduleSHA1(schedule, 23, scheduleRotation));
+  sha1Round2Step(b, c, d, e, a, expandScheduleSHA1(schedule, 24, scheduleRotation));
+
+  sha1Round2Step(a, b, c, d, e, expandScheduleSHA1(schedule, 25, scheduleRotation));
+  sha1Round2Step(e, a, b, c, d, expandScheduleSHA1(schedule, 26, scheduleRotation));
+  sha1Round2Step(d, e, a, b, c, expandScheduleSHA1(schedule, 27, scheduleRotation));
+  sha1Round2Step(c, d, e, a, b, expandScheduleSHA1(schedule, 28, scheduleRotation));
+  sha1Round2Step(b, c, d, e, a, expandScheduleSHA1(schedule, 29, scheduleRotation));
+
+  sha1Round2Step(a, b, c, d, e, expandScheduleSHA1(schedule, 30, scheduleRotation));
+  sha1Round2Step(e, a, b, c, d, expandScheduleSHA1(schedule, 31, scheduleRotation));
+  sha1Round2Step(d, e, a, b, c, expandScheduleSHA1(schedule, 32, scheduleRotation));
+  sha1Round2Step(c, d, e, a, b, expandScheduleSHA1(schedule, 33, scheduleRotation));
+  sha1Round2Step(b, c, d, e, a, expandScheduleSHA1(schedule, 34, scheduleRotation));
+
+  sha1Round2Step(a, b, c, d, e, expandScheduleSHA1(schedule, 35, scheduleRotation));
+  sha1Round2Step(e, a, b, c, d, expandScheduleSHA1(schedule, 36, scheduleRotation));
+  sha1Round2Step(d, e, a, b, c, expandScheduleSHA1(schedule, 37, scheduleRotation));
+  sha1Round2Step(c, d, e, a, b, expandScheduleSHA1(schedule, 38, scheduleRotation));
+  sha1Round2Step(b, c, d, e, a, expandScheduleSHA1(schedule, 39, scheduleRotation));
+
+  /* Round 2 Operations Finish */
+
+  /* Round 3 Operations Start */
+
+  sha1Round3Step(a, b, c, d, e, expandScheduleSHA1(schedule, 40, scheduleRotation));
+  sha1Round3Step(e, a, b, c, d, expandScheduleSHA1(schedule, 41, scheduleRotation));
+  sha1Round3Step(d, e, a, b, c, expandScheduleSHA1(schedule, 42, scheduleRotation));
+  sha1Round3Step(c, d, e, a, b, expandScheduleSHA1(schedule, 43, scheduleRotation));
+  sha1Round3Step(b, c, d, e, a, expandScheduleSHA1(schedule, 44, scheduleRotation));
+
+  sha1Round3Step(a, b, c, d, e, expandScheduleSHA1(schedule, 45, scheduleRotation));
+  sha1Round3Step(e, a, b, c, d, expandScheduleSHA1(schedule, 46, scheduleRotation));
+  sha1Round3Step(d, e, a, b, c, expandScheduleSHA1(schedule, 47, scheduleRotation));
+  sha1Round3Step(c, d, e, a, b, expandScheduleSHA1(schedule, 48, scheduleRotation));
+  sha1Round3Step(b, c, d, e, a, expandScheduleSHA1(schedule, 49, scheduleRotation));
+
+  sha1Round3Step(a, b, c, d, e, expandScheduleSHA1(schedule, 50, scheduleRotation));
+  sha1Round3Step(e, a, b, c, d, expandScheduleSHA1(schedule, 51, scheduleRotation));
+  sha1Round3Step(d, e, a, b, c, expandScheduleSHA1(schedule, 52, scheduleRotation));
+  sha1Round3Step(c, d, e, a, b, expandScheduleSHA1(schedule, 53, scheduleRotation));
+  sha1Round3Step(b, c, d, e, a, expandScheduleSHA1(schedule, 54, scheduleRotation));
+
+  sha1Round3Step(a, b, c, d, e, expandScheduleSHA1(schedule, 55, scheduleRotation));
+  sha1Round3Step(e, a, b, c, d, expandScheduleSHA1(schedule, 56, scheduleRotation));
+  sha1Round3Step(d, e, a, b, c, expandScheduleSHA1(schedule, 57, scheduleRotation));
+  sha1Round3Step(c, d, e, a, b, expandScheduleSHA1(schedule, 58, scheduleRotation));
+  sha1Round3Step(b, c, d, e, a, expandScheduleSHA1(schedule, 59, scheduleRotation));
+
+  /* Round 3 Operations Finish */
+
+  /* Round 4 Operations Start */
+
+  sha1Round4Step(a, b, c, d, e, expandScheduleSHA1(schedule, 60, scheduleRotation));
+  sha1Round4Step(e, a, b, c, d, expandScheduleSHA1(schedule, 61, scheduleRotation));
+  sha1Round4Step(d, e, a, b, c, expandScheduleSHA1(schedule, 62, scheduleRotation));
+  sha1Round4Step(c, d, e, a, b, expandScheduleSHA1(schedule, 63, scheduleRotation));
+  sha1Round4Step(b, c, d, e, a, expandScheduleSHA1(schedule, 64, scheduleRotation));
+
+  sha1Round4Step(a, b, c, d, e, expandScheduleSHA1(schedule, 65, scheduleRotation));
+  sha1Round4Step(e, a, b, c, d, expandScheduleSHA1(schedule, 66, scheduleRotation));
+  sha1Round4Step(d, e, a, b, c, expandScheduleSHA1(schedule, 67, scheduleRotation));
+  sha1Round4Step(c, d, e, a, b, expandScheduleSHA1(schedule, 68, scheduleRotation));
+  sha1Round4Step(b, c, d, e, a, expandScheduleSHA1(schedule, 69, scheduleRotation));
+
+  sha1Round4Step(a, b, c, d, e, expandScheduleSHA1(schedule, 70, scheduleRotation));
+  sha1Round4Step(e, a, b, c, d, expandScheduleSHA1(schedule, 71, scheduleRotation));
+  sha1Round4Step(d, e, a, b, c, expandScheduleSHA1(schedule, 72, scheduleRotation));
+  sha1Round4Step(c, d, e, a, b, expandScheduleSHA1(schedule, 73, scheduleRotation));
+  sha1Round4Step(b, c, d, e, a, expandScheduleSHA1(schedule, 74, scheduleRotation));
+
+  sha1Round4Step(a, b, c, d, e, expandScheduleSHA1(schedule, 75, scheduleRotation));
+  sha1Round4Step(e, a, b, c, d, expandScheduleSHA1(schedule, 76, scheduleRotation));
+  sha1Round4Step(d, e, a, b, c, expandScheduleSHA1(schedule, 77, scheduleRotation));
+  sha1Round4Step(c, d, e, a, b, expandScheduleSHA1(schedule, 78, scheduleRotation));
+  sha1Round4Step(b, c, d, e, a, expandScheduleSHA1(schedule, 79, scheduleRotation));
+
+  /* Round 4 Operations Finish */
+
+  // Add the processed registers onto the saved register state
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  A single step over a schedule word that already has its round constant
+  added on. The callers rotate the roles of the registers as above.
+*/
+template<uint32_t (*mix)(uint32_t, uint32_t, uint32_t)>
+inline void sha1ScheduledStep(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e,
+                              uint32_t scheduledWord) {
+  e += rotationalLeftShift(a, 5) + mix(b, c, d) + scheduledWord;
+  b = rotationalLeftShift(b, 30);
+}
+
+// Rotates each 32 bit lane left by count bits, where count may be 0
+template<unsigned int count>
+__attribute__((target("ssse3")))
+inline __m128i rotationalLeftShift4x32SSSE3(__m128i val) {
+  return _mm_or_si128(_mm_slli_epi32(val, count), _mm_srli_epi32(val, 32 - count));
+}
+
+/*
+  Expands the next four schedule words from the previous sixteen, held in
+  order in words0 through words3
+*/
+template<unsigned int scheduleRotation>
+__attribute__((target("ssse3")))
+inline __m128i expandScheduleSHA1x4(__m128i words0, __m128i words1, __m128i words2, __m128i words3) {
+  // Words 16, 14, 8 and 3 back, leaving out the unknown word in the last lane
+  __m128i result = _mm_xor_si128(_mm_xor_si128(words0, _mm_alignr_epi8(words1, words0, 8)),
+                                 _mm_xor_si128(words2, _mm_srli_si128(words3, 4)));
+  result = rotationalLeftShift4x32SSSE3<scheduleRotation>(result);
+
+  return _mm_xor_si128(result, rotationalLeftShift4x32SSSE3<scheduleRotation>(_mm_slli_si128(result, 12)));
+}
+
+/*
+  Fills scheduledWords[first] up to scheduledWords[last] with expanded words
+  plus constant, advancing words0 through words3 as it goes
+*/
+template<unsigned int scheduleRotation>
+__attribute__((target("ssse3")))
+inline void expandScheduleSHA1Range(__m128i &words0, __m128i &words1, __m128i &words2, __m128i &words3,
+                                    uint32_t scheduledWords[], short first, short last, uint32_t constant) {
+  for(short word = first; word < last; word += 4) {
+    __m128i next = expandScheduleSHA1x4<scheduleRotation>(words0, words1, words2, words3);
+
+    words0 = words1;
+    words1 = words2;
+    words2 = words3;
+    words3 = next;
+
+    _mm_store_si128((__m128i *)(scheduledWords + word), _mm_add_epi32(next, _mm_set1_epi32(constant)));
+  }
+}
+
+/*
+  Single stream SHA0 and SHA1 for CPUs without the SHA extensions. The whole
+  message schedule, with the round constants added on, is expanded four
+  words at a time in vector registers, one round ahead of the scalar rounds.
+
+  The last word of each group of four depends on the first, so it is first
+  expanded without that term, which is then rotated and XORd in once the
+  first word is known.
+
+  A single block's schedule only fills 128 bit registers, so SSSE3 is all
+  this needs and AVX2 hosts run the same code.
+*/
+template<unsigned int scheduleRotation>
+__attribute__((target("ssse3")))
+void sha1processBlockSSSE3(const uint8_t block[64], uint32_t registers[5]) {
+  // Reverses the bytes of each word, turning big endian words into native ones
+  const __m128i byteSwap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+  /* Create the first 16 words of the message schedule */
+  alignas(16) uint32_t schedule[80];
+
+  __m128i words0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), byteSwap);
+  __m128i words1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16)), byteSwap);
+  __m128i words2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 32)), byteSwap);
+  __m128i words3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 48)), byteSwap);
+
+  const __m128i firstConstant = _mm_set1_epi32(1518500249); // 0x5a827999
+  _mm_store_si128((__m128i *)schedule, _mm_add_epi32(words0, firstConstant));
+  _mm_store_si128((__m128i *)(schedule + 4), _mm_add_epi32(words1, firstConstant));
+  _mm_store_si128((__m128i *)(schedule + 8), _mm_add_epi32(words2, firstConstant));
+  _mm_store_si128((__m128i *)(schedule + 12), _mm_add_epi32(words3, firstConstant));
+
+  uint32_t a = registers[0];
+  uint32_t b = registers[1];
+  uint32_t c = registers[2];
+  uint32_t d = registers[3];
+  uint32_t e = registers[4];
+
+  /*
+    Each round's words are expanded just before the round before it runs, so
+    the vector work overlaps the scalar dependency chain instead of running
+    ahead of it
+  */
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 16, 20, 1518500249);
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 20, 36, 1859775393);
+  for(short word = 0; word < 20; word += 5) {
+    sha1ScheduledStep<choice>(a, b, c, d, e, schedule[word]);
+    sha1ScheduledStep<choice>(e, a, b, c, d, schedule[word + 1]);
+    sha1ScheduledStep<choice>(d, e, a, b, c, schedule[word + 2]);
+    sha1ScheduledStep<choice>(c, d, e, a, b, schedule[word + 3]);
+    sha1ScheduledStep<choice>(b, c, d, e, a, schedule[word + 4]);
+  }
+
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 36, 40, 1859775393);
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 40, 56, 2400959708);
+  for(short word = 20; word < 40; word += 5) {
+    sha1ScheduledStep<parity>(a, b, c, d, e, schedule[word]);
+    sha1ScheduledStep<parity>(e, a, b, c, d, schedule[word + 1]);
+    sha1ScheduledStep<parity>(d, e, a, b, c, schedule[word + 2]);
+    sha1ScheduledStep<parity>(c, d, e, a, b, schedule[word + 3]);
+    sha1ScheduledStep<parity>(b, c, d, e, a, schedule[word + 4]);
   }
+
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 56, 60, 2400959708);
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 60, 76, 3395469782);
+  for(short word = 40; word < 60; word += 5) {
+    sha1ScheduledStep<majority>(a, b, c, d, e, schedule[word]);
+    sha1ScheduledStep<majority>(e, a, b, c, d, schedule[word + 1]);
+    sha1ScheduledStep<majority>(d, e, a, b, c, schedule[word + 2]);
+    sha1ScheduledStep<majority>(c, d, e, a, b, schedule[word + 3]);
+    sha1ScheduledStep<majority>(b, c, d, e, a, schedule[word + 4]);
+  }
+
+  expandScheduleSHA1Range<scheduleRotation>(words0, words1, words2, words3, schedule, 76, 80, 3395469782);
+  for(short word = 60; word < 80; word += 5) {
+    sha1ScheduledStep<parity>(a, b, c, d, e, schedule[word]);
+    sha1ScheduledStep<parity>(e, a, b, c, d, schedule[word + 1]);
+    sha1ScheduledStep<parity>(d, e, a, b, c, schedule[word + 2]);
+    sha1ScheduledStep<parity>(c, d, e, a, b, schedule[word + 3]);
+    sha1ScheduledStep<parity>(b, c, d, e, a, schedule[word + 4]);
+  }
+
+  // Add the processed registers onto the saved register state
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+}
+
+#endif
+
+void sha0processBlockPortable(const uint8_t block[64], uint32_t registers[5]) {
+  sha1compressBlock(block, registers, 0);
 }
 
-string sha256(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-                                          // of the pad buffer
+/*
+  Compresses a single block with the best kernel for the CPU, picked once at
+  startup by selectKernels()
+*/
+void (*sha0processBlock)(const uint8_t block[64], uint32_t registers[5]) = sha0processBlockPortable;
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
+// Starting state shared by SHA0 and SHA1
+const uint32_t sha1StartingState[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+const Sha0Traits::Word *Sha0Traits::startingState() {
+  return sha1StartingState;
+}
 
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
+void Sha0Traits::processBlock(const uint8_t block[], Word registers[]) {
+  sha0processBlock(block, registers);
+}
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+template class MerkleDamgardCtx<Sha0Traits>;
 
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+string sha0(const void *data, size_t length) {
+  Sha0Ctx ctx;
+  ctx.update(data, length);
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+  return ctx.finalize();
+}
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
+string sha0(string_view data) {
+  return sha0(data.data(), data.length());
+}
+
+Digest<20> sha0Digest(const void *data, size_t length) {
+  Sha0Ctx ctx;
+  ctx.update(data, length);
+
+  return ctx.finalizeDigest();
+}
+
+Digest<20> sha0Digest(string_view data) {
+  return sha0Digest(data.data(), data.length());
+}
+
+/*---------------------------------------------------------------------------*/
+/*                            Begin SHA1 Section                             */
+/*---------------------------------------------------------------------------*/
+
+/*
+  SHA1 Algorithm designed using the specifications described in
+
+  NIST FIPS Publication 180-4
+
+  published in August 2015
+*/
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  SHA1 compression using the SHA extensions. sha1rnds4 runs four rounds on
+  A-D, taking E already added onto the four schedule words, and sha1nexte
+  derives the next E from the previous A while adding it on. sha1msg1,
+  a plain XOR and sha1msg2 expand the schedule four words at a time.
+
+  SHA0 can't use these, since sha1msg2 always applies the SHA1 rotation.
+*/
+__attribute__((target("sha,sse4.1")))
+void sha1processBlockSHANI(const uint8_t block[64], uint32_t registers[5]) {
+  // Reverses the bytes of the whole vector, turning big endian words into
+  // native ones with the first word in the highest lane as the instructions
+  // expect
+  const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607, 0x08090a0b0c0d0e0f);
+
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)registers), 0x1b);
+  __m128i e0 = _mm_set_epi32(registers[4], 0, 0, 0);
+  __m128i e1;
+
+  const __m128i abcdSaved = abcd;
+  const __m128i eSaved = e0;
+
+  __m128i msg0, msg1, msg2, msg3;
+
+  /* Rounds 0-3 */
+  msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 0)), byteSwap);
+  e0 = _mm_add_epi32(e0, msg0);
+  e1 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+  /* Rounds 4-7 */
+  msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16)), byteSwap);
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+  /* Rounds 8-11 */
+  msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 32)), byteSwap);
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  /* Rounds 12-15 */
+  msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 48)), byteSwap);
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  /* Rounds 16-19 */
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  /* Rounds 20-23 */
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  /* Rounds 24-27 */
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  /* Rounds 28-31 */
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  /* Rounds 32-35 */
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  /* Rounds 36-39 */
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  /* Rounds 40-43 */
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  /* Rounds 44-47 */
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  /* Rounds 48-51 */
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  /* Rounds 52-55 */
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  /* Rounds 56-59 */
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  /* Rounds 60-63 */
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  /* Rounds 64-67 */
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  /* Rounds 68-71 */
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  /* Rounds 72-75 */
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+  /* Rounds 76-79 */
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+  // Add the processed registers onto the saved register state. E is only
+  // held implicitly, so it is recovered from the previous A by sha1nexte
+  e0 = _mm_sha1nexte_epu32(e0, eSaved);
+  abcd = _mm_add_epi32(abcd, abcdSaved);
+
+  _mm_storeu_si128((__m128i *)registers, _mm_shuffle_epi32(abcd, 0x1b));
+  registers[4] = _mm_extract_epi32(e0, 3);
+}
+
+
+#endif
+
+void sha1processBlockPortable(const uint8_t block[64], uint32_t registers[5]) {
+  sha1compressBlock(block, registers, 1);
+}
+
+/*
+  Compresses a single block with the best kernel for the CPU, picked once at
+  startup by selectKernels()
+*/
+void (*sha1processBlock)(const uint8_t block[64], uint32_t registers[5]) = sha1processBlockPortable;
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  Multi-buffer SHA1, running one block from each of 8 independent messages
+  side by side, one message per 32 bit lane. The schedule expansion and
+  steps mirror the ones above with every register holding the same word of
+  all 8 lanes.
+*/
+__attribute__((target("avx2")))
+inline __m256i expandScheduleSHA1x8(__m256i schedule[16], short round) {
+  __m256i result = _mm256_xor_si256(_mm256_xor_si256(schedule[(round - 3) & 15], schedule[(round - 8) & 15]),
+                                    _mm256_xor_si256(schedule[(round - 14) & 15], schedule[round & 15]));
+
+  return schedule[round & 15] = rotationalLeftShift8x32(result, 1);
+}
+
+__attribute__((target("avx2")))
+inline void sha1StepX8(__m256i a, __m256i &b, __m256i &e, __m256i mix, __m256i scheduleWord, uint32_t constant) {
+  e = _mm256_add_epi32(_mm256_add_epi32(e, rotationalLeftShift8x32(a, 5)),
+                       _mm256_add_epi32(_mm256_add_epi32(mix, scheduleWord), _mm256_set1_epi32(constant)));
+  b = rotationalLeftShift8x32(b, 30);
+}
+
+__attribute__((target("avx2")))
+inline void sha1Round1Step8(__m256i a, __m256i &b, __m256i c, __m256i d, __m256i &e, __m256i scheduleWord) {
+  __m256i mix = _mm256_xor_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d));
+  sha1StepX8(a, b, e, mix, scheduleWord, 1518500249); // 0x5a827999
+}
+
+__attribute__((target("avx2")))
+inline void sha1Round2Step8(__m256i a, __m256i &b, __m256i c, __m256i d, __m256i &e, __m256i scheduleWord) {
+  __m256i mix = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  sha1StepX8(a, b, e, mix, scheduleWord, 1859775393); // 0x6ed9eba1
+}
+
+__attribute__((target("avx2")))
+inline void sha1Round3Step8(__m256i a, __m256i &b, __m256i c, __m256i d, __m256i &e, __m256i scheduleWord) {
+  __m256i mix = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+  sha1StepX8(a, b, e, mix, scheduleWord, 2400959708); // 0x8f1bbcdc
+}
+
+__attribute__((target("avx2")))
+inline void sha1Round4Step8(__m256i a, __m256i &b, __m256i c, __m256i d, __m256i &e, __m256i scheduleWord) {
+  __m256i mix = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  sha1StepX8(a, b, e, mix, scheduleWord, 3395469782); // 0xca62c1d6
+}
+
+__attribute__((target("avx2")))
+void sha1processBlocks8AVX2(const uint8_t *blocks[8], uint32_t state[5][8]) {
+  /* Create the first 16 words of the message schedule */
+  __m256i schedule[16];
+  loadWords8x32(blocks, schedule, true);
+
+  __m256i registers[5];
+  for(short pos = 0; pos < 5; ++pos)
+    registers[pos] = _mm256_load_si256((const __m256i *)state[pos]);
+
+  __m256i a = registers[0];
+  __m256i b = registers[1];
+  __m256i c = registers[2];
+  __m256i d = registers[3];
+  __m256i e = registers[4];
+
+  /* Round 1 Operations Start */
+
+  sha1Round1Step8(a, b, c, d, e, schedule[0]);
+  sha1Round1Step8(e, a, b, c, d, schedule[1]);
+  sha1Round1Step8(d, e, a, b, c, schedule[2]);
+  sha1Round1Step8(c, d, e, a, b, schedule[3]);
+  sha1Round1Step8(b, c, d, e, a, schedule[4]);
+
+  sha1Round1Step8(a, b, c, d, e, schedule[5]);
+  sha1Round1Step8(e, a, b, c, d, schedule[6]);
+  sha1Round1Step8(d, e, a, b, c, schedule[7]);
+  sha1Round1Step8(c, d, e, a, b, schedule[8]);
+  sha1Round1Step8(b, c, d, e, a, schedule[9]);
+
+  sha1Round1Step8(a, b, c, d, e, schedule[10]);
+  sha1Round1Step8(e, a, b, c, d, schedule[11]);
+  sha1Round1Step8(d, e, a, b, c, schedule[12]);
+  sha1Round1Step8(c, d, e, a, b, schedule[13]);
+  sha1Round1Step8(b, c, d, e, a, schedule[14]);
+
+  sha1Round1Step8(a, b, c, d, e, schedule[15]);
+  sha1Round1Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 16));
+  sha1Round1Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 17));
+  sha1Round1Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 18));
+  sha1Round1Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 19));
+
+  /* Round 1 Operations Finish */
+
+  /* Round 2 Operations Start */
+
+  sha1Round2Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 20));
+  sha1Round2Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 21));
+  sha1Round2Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 22));
+  sha1Round2Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 23));
+  sha1Round2Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 24));
+
+  sha1Round2Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 25));
+  sha1Round2Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 26));
+  sha1Round2Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 27));
+  sha1Round2Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 28));
+  sha1Round2Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 29));
+
+  sha1Round2Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 30));
+  sha1Round2Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 31));
+  sha1Round2Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 32));
+  sha1Round2Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 33));
+  sha1Round2Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 34));
+
+  sha1Round2Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 35));
+  sha1Round2Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 36));
+  sha1Round2Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 37));
+  sha1Round2Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 38));
+  sha1Round2Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 39));
+
+  /* Round 2 Operations Finish */
+
+  /* Round 3 Operations Start */
+
+  sha1Round3Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 40));
+  sha1Round3Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 41));
+  sha1Round3Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 42));
+  sha1Round3Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 43));
+  sha1Round3Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 44));
+
+  sha1Round3Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 45));
+  sha1Round3Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 46));
+  sha1Round3Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 47));
+  sha1Round3Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 48));
+  sha1Round3Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 49));
+
+  sha1Round3Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 50));
+  sha1Round3Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 51));
+  sha1Round3Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 52));
+  sha1Round3Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 53));
+  sha1Round3Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 54));
+
+  sha1Round3Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 55));
+  sha1Round3Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 56));
+  sha1Round3Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 57));
+  sha1Round3Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 58));
+  sha1Round3Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 59));
+
+  /* Round 3 Operations Finish */
+
+  /* Round 4 Operations Start */
+
+  sha1Round4Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 60));
+  sha1Round4Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 61));
+  sha1Round4Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 62));
+  sha1Round4Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 63));
+  sha1Round4Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 64));
+
+  sha1Round4Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 65));
+  sha1Round4Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 66));
+  sha1Round4Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 67));
+  sha1Round4Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 68));
+  sha1Round4Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 69));
+
+  sha1Round4Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 70));
+  sha1Round4Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 71));
+  sha1Round4Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 72));
+  sha1Round4Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 73));
+  sha1Round4Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 74));
+
+  sha1Round4Step8(a, b, c, d, e, expandScheduleSHA1x8(schedule, 75));
+  sha1Round4Step8(e, a, b, c, d, expandScheduleSHA1x8(schedule, 76));
+  sha1Round4Step8(d, e, a, b, c, expandScheduleSHA1x8(schedule, 77));
+  sha1Round4Step8(c, d, e, a, b, expandScheduleSHA1x8(schedule, 78));
+  sha1Round4Step8(b, c, d, e, a, expandScheduleSHA1x8(schedule, 79));
+
+  /* Round 4 Operations Finish */
+
+  // Add the processed registers onto the saved register state
+  _mm256_store_si256((__m256i *)state[0], _mm256_add_epi32(registers[0], a));
+  _mm256_store_si256((__m256i *)state[1], _mm256_add_epi32(registers[1], b));
+  _mm256_store_si256((__m256i *)state[2], _mm256_add_epi32(registers[2], c));
+  _mm256_store_si256((__m256i *)state[3], _mm256_add_epi32(registers[3], d));
+  _mm256_store_si256((__m256i *)state[4], _mm256_add_epi32(registers[4], e));
+}
+
+#endif
+
+const Sha1Traits::Word *Sha1Traits::startingState() {
+  return sha1StartingState;
+}
+
+void Sha1Traits::processBlock(const uint8_t block[], Word registers[]) {
+  sha1processBlock(block, registers);
+}
+
+template class MerkleDamgardCtx<Sha1Traits>;
+
+string sha1(const void *data, size_t length) {
+  Sha1Ctx ctx;
+  ctx.update(data, length);
+
+  return ctx.finalize();
+}
+
+string sha1(string_view data) {
+  return sha1(data.data(), data.length());
+}
+
+Digest<20> sha1Digest(const void *data, size_t length) {
+  Sha1Ctx ctx;
+  ctx.update(data, length);
+
+  return ctx.finalizeDigest();
+}
+
+Digest<20> sha1Digest(string_view data) {
+  return sha1Digest(data.data(), data.length());
+}
+
+/*
+  Hashes every message of a batch, 8 at a time with AVX2 or otherwise one
+  after another. A lane whose message finishes early is refilled with the
+  next waiting one straight away, so all 8 stay busy until the batch runs
+  out. Unlike SHA256, 8 lanes of AVX2 keep up with a single stream through
+  the SHA extensions, so they are preferred even where those are available.
+*/
+vector<Digest<20>> sha1Batch(const string_view data[], size_t count) {
+  vector<Digest<20>> digests(count);
+
+  auto store = [&digests](size_t message, const uint32_t registers[]) {
+    for(short pos = 0; pos < 5; ++pos)
+      storeBigEndian32(digests[message].data() + pos * 4, registers[pos]);
+  };
+
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasAVX2 && calibratedBatchLanes(batchSha1, data, count) != 1) {
+    hashBatch<uint32_t, 8, 5, 64, 8, true>(data, count, sha1StartingState,
+                                           sha1processBlocks8AVX2, store);
+    return digests;
   }
+#endif
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+  auto kernel = [](const uint8_t *blocks[], uint32_t state[][1]) {
+    uint32_t registers[5];
+    for(short pos = 0; pos < 5; ++pos)
+      registers[pos] = state[pos][0];
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+    sha1processBlock(blocks[0], registers);
 
-  padPos = padLength - 1;
+    for(short pos = 0; pos < 5; ++pos)
+      state[pos][0] = registers[pos];
+  };
 
-  uint64_t val = lengthHolder;
-  uint64_t temp = 0;
+  hashBatch<uint32_t, 1, 5, 64, 8, true>(data, count, sha1StartingState, kernel, store);
+  return digests;
+}
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 63; ++bitPos) {
-    bool bit = val & (1l << bitPos);
+vector<Digest<20>> sha1Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-    padBuffer[padPos] = bit;
+  return sha1Batch(views.data(), views.size());
+}
 
-    if(bit) {
-      temp += 1l << bitPos;
-      if(temp == val)
-        break;
-    }
+/*---------------------------------------------------------------------------*/
+/*                           Begin SHA256 Section                            */
+/*---------------------------------------------------------------------------*/
+
+/*
+  SHA256 Algorithm designed using the specifications described in
+
+  NIST FIPS Publication 180-4
+
+  published in August 2015
+*/
+
+/*
+  The lower sigma 0 (σ0) function for SHA224 and SHA256, defined as follows:
+
+  Given a 32 bit number, create another 32 bit number by performing the following
+
+  Rotational Right Shift of 7 bits from the original number XORd with
+  Rotational Right Shift of 18 bits from the original number XORd with
+  Right Shift of 3 bits from the original number
+*/
+uint32_t lowerSigma0_256(uint32_t val) {
+  return rotationalRightShift(val, 7) ^ rotationalRightShift(val, 18) ^ (val >> 3);
+}
+
+/*
+  The lower sigma 1 (σ1) function for SHA224 and SHA256, defined as follows:
+
+  Given a 32 bit number, create another 32 bit number by performing the following
+
+  Rotational Right Shift of 17 bits from the original number XORd with
+  Rotational Right Shift of 19 bits from the original number XORd with
+  Right Shift of 10 bits from the original number
+*/
+uint32_t lowerSigma1_256(uint32_t val) {
+  return rotationalRightShift(val, 17) ^ rotationalRightShift(val, 19) ^ (val >> 10);
+}
 
-    --padPos;
+/*
+  The upper sigma 0 (Σ0) function for SHA224 and SHA256, defined as follows:
+
+  Given a 32 bit number, create another 32 bit number by performing the following
+
+  Rotational Right Shift of 2 bits from the original number XORd with
+  Rotational Right Shift of 13 bits from the original number XORd with
+  Rotational Right Shift of 22 bits from the original number
+*/
+uint32_t upperSigma0_256(uint32_t val) {
+  return rotationalRightShift(val, 2) ^ rotationalRightShift(val, 13) ^ rotationalRightShift(val, 22);
+}
+
+/*
+  The upper sigma 1 (Σ1) function for SHA224 and SHA256, defined as follows:
+
+  Given a 32 bit number, create another 32 bit number by performing the following
+
+  Rotational Right Shift of 6 bits from the original number XORd with
+  Rotational Right Shift of 11 bits from the original number XORd with
+  Rotational Right Shift of 25 bits from the original number
+*/
+uint32_t upperSigma1_256(uint32_t val) {
+  return rotationalRightShift(val, 6) ^ rotationalRightShift(val, 11) ^ rotationalRightShift(val, 25);
+}
+
+// Message schedule generation function used by SHA224 and SHA256
+void generateSchedule256(const uint8_t block[64], uint32_t schedule[64]) {
+  // Create the first 16 32-bit words using the message block
+  for(short schedulePos = 0; schedulePos < 16; ++schedulePos)
+    schedule[schedulePos] = loadBigEndian32(block + schedulePos * 4);
+
+  // Expand the schedule to 64 32-bit words
+  for(short schedulePos = 16; schedulePos < 64; ++schedulePos)
+    schedule[schedulePos] = lowerSigma1_256(schedule[schedulePos - 2]) + schedule[schedulePos - 7] +
+                            lowerSigma0_256(schedule[schedulePos - 15]) + schedule[schedulePos - 16];
+}
+
+/*
+  The constants are the first 32 bits of the fractional parts of the cube
+  roots of the first 64 primes, and the starting register states the first 32
+  bits of the fractional parts of the square roots of the first 8 primes.
+
+  Scaling a prime by 2^96 (or 2^64 for square roots) before taking the
+  integer root leaves those fractional bits as the low 32 bits of the result,
+  so both tables are generated entirely at compile time.
+*/
+constexpr array<uint32_t, 64> generateConstants256() {
+  array<uint32_t, 64> constArray = {};
+
+  for(int prime = 0; prime < 64; ++prime)
+    constArray[prime] = (uint32_t)integerCubeRoot((uint128_t)nthPrime(prime + 1) << 96);
+
+  return constArray;
+}
+
+constexpr array<uint32_t, 8> generateStartingHashState256() {
+  array<uint32_t, 8> registers = {};
+
+  for(int prime = 0; prime < 8; ++prime)
+    registers[prime] = (uint32_t)integerSquareRoot((uint128_t)nthPrime(prime + 1) << 64);
+
+  return registers;
+}
+
+constexpr array<uint32_t, 64> sha256Constants = generateConstants256();
+constexpr array<uint32_t, 8> sha256StartingState = generateStartingHashState256();
+
+static_assert(sha256Constants[0] == 0x428a2f98 && sha256Constants[63] == 0xc67178f2,
+              "SHA256 constants generated incorrectly");
+static_assert(sha256StartingState[0] == 0x6a09e667 && sha256StartingState[7] == 0x5be0cd19,
+              "SHA256 starting state generated incorrectly");
+
+/*
+  A single round, defined as follows:
+
+  temp1 = H + upperSigma1(E) + choice(E, F, G) + scheduledWord
+  temp2 = upperSigma0(A) + majority(A, B, C)
+  D = D + temp1
+  H = temp1 + temp2
+
+  Instead of shifting every register to the right after each round, the
+  caller rotates the roles of the registers. All additions are taken modulo
+  2^32 through unsigned overflow.
+*/
+inline void sha256Round(uint32_t a, uint32_t b, uint32_t c, uint32_t &d,
+                        uint32_t e, uint32_t f, uint32_t g, uint32_t &h, uint32_t scheduledWord) {
+  uint32_t temp1 = h + upperSigma1_256(e) + choice(e, f, g) + scheduledWord;
+
+  d += temp1;
+  h = temp1 + upperSigma0_256(a) + majority(a, b, c);
+}
+
+/*
+  Runs the 64 rounds over a message schedule that already has the round
+  constants added on, then adds the result onto the registers
+
+  Used in:
+  - SHA224, SHA256
+*/
+inline void sha256compressRounds(uint32_t registers[8], const uint32_t scheduledWords[64]) {
+  uint32_t a = registers[0];
+  uint32_t b = registers[1];
+  uint32_t c = registers[2];
+  uint32_t d = registers[3];
+  uint32_t e = registers[4];
+  uint32_t f = registers[5];
+  uint32_t g = registers[6];
+  uint32_t h = registers[7];
+
+  for(short word = 0; word < 64; word += 8) {
+    sha256Round(a, b, c, d, e, f, g, h, scheduledWords[word]);
+    sha256Round(h, a, b, c, d, e, f, g, scheduledWords[word + 1]);
+    sha256Round(g, h, a, b, c, d, e, f, scheduledWords[word + 2]);
+    sha256Round(f, g, h, a, b, c, d, e, scheduledWords[word + 3]);
+    sha256Round(e, f, g, h, a, b, c, d, scheduledWords[word + 4]);
+    sha256Round(d, e, f, g, h, a, b, c, scheduledWords[word + 5]);
+    sha256Round(c, d, e, f, g, h, a, b, scheduledWords[word + 6]);
+    sha256Round(b, c, d, e, f, g, h, a, scheduledWords[word + 7]);
   }
 
-  // Create constants array and initial state registers
-  uint32_t constants[64];
-  uint32_t stateRegisters[8];
-  generateStartingHashState256(constants, stateRegisters);
-
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
-
-  int blockTrack = 0;
-  uint32_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint32_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      sha256processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+  // Add the processed registers onto the saved register state to obtain the
+  // final resulting register state of the current iteration
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+  registers[5] += f;
+  registers[6] += g;
+  registers[7] += h;
+}
 
-        uint32_t newStateVal = tempVal % 4294967296;
+void sha256processBlockPortable(const uint8_t block[64], uint32_t registers[8], const uint32_t constants[64]) {
+  /* Create message schedule */
+  uint32_t schedule[64];
 
-        stateRegisters[pointer] = newStateVal;
+  generateSchedule256(block, schedule);
 
-        tempVal = 0;
-      }
+  for(short word = 0; word < 64; ++word)
+    schedule[word] += constants[word];
+
+  /* Begin compression process */
+  sha256compressRounds(registers, schedule);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Rotates each 32 bit lane right by count bits
+template<unsigned int count>
+__attribute__((target("ssse3")))
+inline __m128i rotationalRightShift4x32SSSE3(__m128i val) {
+  return _mm_or_si128(_mm_srli_epi32(val, count), _mm_slli_epi32(val, 32 - count));
+}
+
+/*
+  Expands the next four schedule words from the previous sixteen, held in
+  order in words0 through words3, stores them with their round constants
+  added on and moves the window along.
+
+  The lower sigma 1 term of each word depends on the word 2 before it, so
+  the group is finished in two halves: first from the last two words of the
+  previous group, then from the first two new words.
+*/
+__attribute__((target("ssse3")))
+inline void expandScheduleSHA256x4(__m128i &words0, __m128i &words1, __m128i &words2, __m128i &words3,
+                                   uint32_t scheduledWords[4], const uint32_t constants[4]) {
+  __m128i words15 = _mm_alignr_epi8(words1, words0, 4);
+  __m128i words7 = _mm_alignr_epi8(words3, words2, 4);
+
+  __m128i lowerSigma0 = _mm_xor_si128(_mm_xor_si128(rotationalRightShift4x32SSSE3<7>(words15),
+                                                    rotationalRightShift4x32SSSE3<18>(words15)),
+                                      _mm_srli_epi32(words15, 3));
+
+  __m128i next = _mm_add_epi32(_mm_add_epi32(words0, lowerSigma0), words7);
+
+  // The lower sigma 1 of 0 is 0, so the unused half of each step adds nothing
+  __m128i previous = _mm_srli_si128(words3, 8);
+  next = _mm_add_epi32(next, _mm_xor_si128(_mm_xor_si128(rotationalRightShift4x32SSSE3<17>(previous),
+                                                         rotationalRightShift4x32SSSE3<19>(previous)),
+                                           _mm_srli_epi32(previous, 10)));
+
+  previous = _mm_slli_si128(next, 8);
+  next = _mm_add_epi32(next, _mm_xor_si128(_mm_xor_si128(rotationalRightShift4x32SSSE3<17>(previous),
+                                                         rotationalRightShift4x32SSSE3<19>(previous)),
+                                           _mm_srli_epi32(previous, 10)));
+
+  words0 = words1;
+  words1 = words2;
+  words2 = words3;
+  words3 = next;
+
+  _mm_store_si128((__m128i *)scheduledWords, _mm_add_epi32(next, _mm_loadu_si128((const __m128i *)constants)));
+}
+
+/*
+  Single stream SHA256 for CPUs without the SHA extensions. The message
+  schedule is expanded four words at a time in vector registers, with the
+  constants added on, while the rounds run on the scalar unit.
+
+  Each group of four words is expanded alongside four of the rounds, sixteen
+  rounds before it is read, so the vector work overlaps the scalar
+  dependency chain instead of running ahead of it. A single block's schedule
+  only fills 128 bit registers, so SSSE3 is all this needs.
+*/
+__attribute__((target("ssse3")))
+void sha256processBlockSSSE3(const uint8_t block[64], uint32_t registers[8], const uint32_t constants[64]) {
+  // Reverses the bytes of each word, turning big endian words into native ones
+  const __m128i byteSwap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+  /* Create the first 16 words of the message schedule */
+  alignas(16) uint32_t schedule[64];
+
+  __m128i words0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), byteSwap);
+  __m128i words1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16)), byteSwap);
+  __m128i words2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 32)), byteSwap);
+  __m128i words3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 48)), byteSwap);
+
+  _mm_store_si128((__m128i *)schedule, _mm_add_epi32(words0, _mm_loadu_si128((const __m128i *)constants)));
+  _mm_store_si128((__m128i *)(schedule + 4),
+                  _mm_add_epi32(words1, _mm_loadu_si128((const __m128i *)(constants + 4))));
+  _mm_store_si128((__m128i *)(schedule + 8),
+                  _mm_add_epi32(words2, _mm_loadu_si128((const __m128i *)(constants + 8))));
+  _mm_store_si128((__m128i *)(schedule + 12),
+                  _mm_add_epi32(words3, _mm_loadu_si128((const __m128i *)(constants + 12))));
+
+  /* Begin compression process */
+  uint32_t a = registers[0];
+  uint32_t b = registers[1];
+  uint32_t c = registers[2];
+  uint32_t d = registers[3];
+  uint32_t e = registers[4];
+  uint32_t f = registers[5];
+  uint32_t g = registers[6];
+  uint32_t h = registers[7];
+
+  for(short word = 0; word < 48; word += 8) {
+    expandScheduleSHA256x4(words0, words1, words2, words3, schedule + word + 16, constants + word + 16);
+    sha256Round(a, b, c, d, e, f, g, h, schedule[word]);
+    sha256Round(h, a, b, c, d, e, f, g, schedule[word + 1]);
+    sha256Round(g, h, a, b, c, d, e, f, schedule[word + 2]);
+    sha256Round(f, g, h, a, b, c, d, e, schedule[word + 3]);
+
+    expandScheduleSHA256x4(words0, words1, words2, words3, schedule + word + 20, constants + word + 20);
+    sha256Round(e, f, g, h, a, b, c, d, schedule[word + 4]);
+    sha256Round(d, e, f, g, h, a, b, c, schedule[word + 5]);
+    sha256Round(c, d, e, f, g, h, a, b, schedule[word + 6]);
+    sha256Round(b, c, d, e, f, g, h, a, schedule[word + 7]);
+  }
+
+  // The last 16 words are already expanded
+  for(short word = 48; word < 64; word += 8) {
+    sha256Round(a, b, c, d, e, f, g, h, schedule[word]);
+    sha256Round(h, a, b, c, d, e, f, g, schedule[word + 1]);
+    sha256Round(g, h, a, b, c, d, e, f, schedule[word + 2]);
+    sha256Round(f, g, h, a, b, c, d, e, schedule[word + 3]);
+    sha256Round(e, f, g, h, a, b, c, d, schedule[word + 4]);
+    sha256Round(d, e, f, g, h, a, b, c, schedule[word + 5]);
+    sha256Round(c, d, e, f, g, h, a, b, schedule[word + 6]);
+    sha256Round(b, c, d, e, f, g, h, a, schedule[word + 7]);
+  }
+
+  // Add the processed registers onto the saved register state
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+  registers[5] += f;
+  registers[6] += g;
+  registers[7] += h;
+}
+
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  SHA256 compression using the SHA extensions. The instructions keep the
+  state as the pairs ABEF and CDGH, and sha256rnds2 runs two rounds taking
+  the next two schedule words with their constants already added on.
+  sha256msg1, an aligned add of the words 7 back and sha256msg2 expand the
+  schedule four words at a time.
+*/
+__attribute__((target("sha,sse4.1")))
+inline void sha256RoundsSHANI(__m128i &abef, __m128i &cdgh, __m128i words, const uint32_t constants[4]) {
+  __m128i scheduled = _mm_add_epi32(words, _mm_loadu_si128((const __m128i *)constants));
+
+  // Each pair of rounds turns ABEF into the next CDGH
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, scheduled);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(scheduled, 0x0e));
+}
+
+__attribute__((target("sha,sse4.1")))
+inline __m128i sha256ExpandSHANI(__m128i words0, __m128i words1, __m128i words2, __m128i words3) {
+  return _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(words0, words1),
+                                            _mm_alignr_epi8(words3, words2, 4)), words3);
+}
+
+__attribute__((target("sha,sse4.1")))
+void sha256processBlockSHANI(const uint8_t block[64], uint32_t registers[8], const uint32_t constants[64]) {
+  // Reverses the bytes of each word, turning big endian words into native ones
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+  /* Rearrange the state registers into ABEF and CDGH */
+  __m128i dcba = _mm_loadu_si128((const __m128i *)registers);
+  __m128i hgfe = _mm_loadu_si128((const __m128i *)(registers + 4));
+
+  __m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+  __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+
+  __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+  __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+  const __m128i abefSaved = abef;
+  const __m128i cdghSaved = cdgh;
+
+  /* Create the first 16 words of the message schedule */
+  __m128i words0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), byteSwap);
+  __m128i words1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16)), byteSwap);
+  __m128i words2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 32)), byteSwap);
+  __m128i words3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 48)), byteSwap);
+
+  /* Begin compression process, 16 rounds at a time */
+  for(short round = 0; round < 48; round += 16) {
+    sha256RoundsSHANI(abef, cdgh, words0, constants + round);
+    sha256RoundsSHANI(abef, cdgh, words1, constants + round + 4);
+    sha256RoundsSHANI(abef, cdgh, words2, constants + round + 8);
+    sha256RoundsSHANI(abef, cdgh, words3, constants + round + 12);
+
+    words0 = sha256ExpandSHANI(words0, words1, words2, words3);
+    words1 = sha256ExpandSHANI(words1, words2, words3, words0);
+    words2 = sha256ExpandSHANI(words2, words3, words0, words1);
+    words3 = sha256ExpandSHANI(words3, words0, words1, words2);
+  }
+
+  sha256RoundsSHANI(abef, cdgh, words0, constants + 48);
+  sha256RoundsSHANI(abef, cdgh, words1, constants + 52);
+  sha256RoundsSHANI(abef, cdgh, words2, constants + 56);
+  sha256RoundsSHANI(abef, cdgh, words3, constants + 60);
+
+  // Add the processed registers onto the saved register state
+  abef = _mm_add_epi32(abef, abefSaved);
+  cdgh = _mm_add_epi32(cdgh, cdghSaved);
+
+  /* Put the state registers back in order */
+  __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+  __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+
+  _mm_storeu_si128((__m128i *)registers, _mm_blend_epi16(feba, dchg, 0xf0));
+  _mm_storeu_si128((__m128i *)(registers + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#endif
+
+/*
+  Compresses a single block with the best kernel for the CPU, picked once at
+  startup by selectKernels(): the SHA extensions where the CPU has them or
+  otherwise the vectorized schedule with SSSE3
+
+  Used in:
+  - SHA224, SHA256
+*/
+void (*sha256processBlock)(const uint8_t block[64], uint32_t registers[8],
+                           const uint32_t constants[64]) = sha256processBlockPortable;
+
+const Sha256Traits::Word *Sha256Traits::startingState() {
+  return sha256StartingState.data();
+}
+
+void Sha256Traits::processBlock(const uint8_t block[], Word registers[]) {
+  sha256processBlock(block, registers, sha256Constants.data());
+}
+
+template class MerkleDamgardCtx<Sha256Traits>;
+
+string sha256(const void *data, size_t length) {
+  Sha256Ctx ctx;
+  ctx.update(data, length);
+
+  return ctx.finalize();
+}
+
+string sha256(string_view data) {
+  return sha256(data.data(), data.length());
+}
+
+Digest<32> sha256Digest(const void *data, size_t length) {
+  Sha256Ctx ctx;
+  ctx.update(data, length);
+
+  return ctx.finalizeDigest();
+}
+
+Digest<32> sha256Digest(string_view data) {
+  return sha256Digest(data.data(), data.length());
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  Multi-buffer SHA256 compression, running one block from each of 8
+  independent messages side by side, one message per 32 bit lane
+
+  Used in:
+  - SHA224, SHA256
+*/
+__attribute__((target("avx2")))
+void sha256processBlocks8AVX2(const uint8_t *blocks[8], uint32_t state[8][8], const uint32_t constants[64]) {
+  /* Create the first 16 words of the message schedule */
+  __m256i schedule[16];
+  loadWords8x32(blocks, schedule, true);
+
+  /* Begin compression process */
+  __m256i registers[8];
+  for(short pos = 0; pos < 8; ++pos)
+    registers[pos] = _mm256_load_si256((const __m256i *)state[pos]);
+
+  __m256i a = registers[0];
+  __m256i b = registers[1];
+  __m256i c = registers[2];
+  __m256i d = registers[3];
+  __m256i e = registers[4];
+  __m256i f = registers[5];
+  __m256i g = registers[6];
+  __m256i h = registers[7];
 
-      blockTrack = 0;
+  for(short word = 0; word < 64; ++word) {
+    // Expand the schedule in place, keeping only the last 16 words
+    if(word >= 16) {
+      __m256i word2 = schedule[(word - 2) & 15];
+      __m256i word15 = schedule[(word - 15) & 15];
+
+      __m256i lowerSigma1 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift8x32(word2, 17),
+                                                              rotationalRightShift8x32(word2, 19)),
+                                             _mm256_srli_epi32(word2, 10));
+      __m256i lowerSigma0 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift8x32(word15, 7),
+                                                              rotationalRightShift8x32(word15, 18)),
+                                             _mm256_srli_epi32(word15, 3));
+
+      schedule[word & 15] = _mm256_add_epi32(_mm256_add_epi32(schedule[word & 15], lowerSigma1),
+                                             _mm256_add_epi32(schedule[(word - 7) & 15], lowerSigma0));
     }
+
+    __m256i upperSigma1 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift8x32(e, 6),
+                                                            rotationalRightShift8x32(e, 11)),
+                                           rotationalRightShift8x32(e, 25));
+    __m256i upperSigma0 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift8x32(a, 2),
+                                                            rotationalRightShift8x32(a, 13)),
+                                           rotationalRightShift8x32(a, 22));
+
+    __m256i choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+
+    __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, upperSigma1),
+                                     _mm256_add_epi32(_mm256_add_epi32(choice, schedule[word & 15]),
+                                                      _mm256_set1_epi32(constants[word])));
+    __m256i temp2 = _mm256_add_epi32(upperSigma0, majority);
+
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(temp1, temp2);
+  }
+
+  // Add the processed registers onto the saved register state
+  _mm256_store_si256((__m256i *)state[0], _mm256_add_epi32(registers[0], a));
+  _mm256_store_si256((__m256i *)state[1], _mm256_add_epi32(registers[1], b));
+  _mm256_store_si256((__m256i *)state[2], _mm256_add_epi32(registers[2], c));
+  _mm256_store_si256((__m256i *)state[3], _mm256_add_epi32(registers[3], d));
+  _mm256_store_si256((__m256i *)state[4], _mm256_add_epi32(registers[4], e));
+  _mm256_store_si256((__m256i *)state[5], _mm256_add_epi32(registers[5], f));
+  _mm256_store_si256((__m256i *)state[6], _mm256_add_epi32(registers[6], g));
+  _mm256_store_si256((__m256i *)state[7], _mm256_add_epi32(registers[7], h));
+}
+
+#endif
+
+/*
+  Hashes every message of a batch, keeping the first digestSize bytes of each
+  result. With AVX2, 8 messages are run at a time through the multi-buffer
+  kernel. Otherwise, or if the SHA extensions are available since a single
+  stream through them outpaces 8 lanes of AVX2, the messages are hashed one
+  after another.
+
+  Used in:
+  - SHA224, SHA256
+*/
+template<size_t digestSize>
+vector<Digest<digestSize>> sha256processBatch(const string_view data[], size_t count,
+                                              const uint32_t startingState[8]) {
+  vector<Digest<digestSize>> digests(count);
+
+  auto store = [&digests](size_t message, const uint32_t registers[]) {
+    for(size_t pos = 0; pos < digestSize / 4; ++pos)
+      storeBigEndian32(digests[message].data() + pos * 4, registers[pos]);
+  };
+
+#if defined(__x86_64__) || defined(__i386__)
+  short lanes = calibratedBatchLanes(batchSha256, data, count);
+
+  if(cpuHasAVX2 && (lanes == 8 || (lanes == 0 && !cpuHasShaExtensions))) {
+    auto kernel = [](const uint8_t *blocks[], uint32_t state[][8]) {
+      sha256processBlocks8AVX2(blocks, state, sha256Constants.data());
+    };
+
+    hashBatch<uint32_t, 8, 8, 64, 8, true>(data, count, startingState, kernel, store);
+    return digests;
   }
+#endif
 
-  /* Convert resulting state registers to hexadecimal notation */
+  auto kernel = [](const uint8_t *blocks[], uint32_t state[][1]) {
+    uint32_t registers[8];
+    for(short pos = 0; pos < 8; ++pos)
+      registers[pos] = state[pos][0];
 
-  return hexDigest(stateRegisters, 8);
+    sha256processBlock(blocks[0], registers, sha256Constants.data());
+
+    for(short pos = 0; pos < 8; ++pos)
+      state[pos][0] = registers[pos];
+  };
+
+  hashBatch<uint32_t, 1, 8, 64, 8, true>(data, count, startingState, kernel, store);
+  return digests;
+}
+
+vector<Digest<32>> sha256Batch(const string_view data[], size_t count) {
+  return sha256processBatch<32>(data, count, sha256StartingState.data());
+}
+
+vector<Digest<32>> sha256Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
+
+  return sha256Batch(views.data(), views.size());
 }
 
 /*---------------------------------------------------------------------------*/
@@ -3326,1183 +3572,1278 @@ string sha256(string data) {
   - Output is generated by omitting the 8th state register's value
 */
 
-void generateStartingHashState224(uint32_t constArray[64], uint32_t registers[8]) {
-  union {
-    double input;
-    uint64_t output;
-  } data;
+/*
+  The starting register states are the second set of 32 bits of the
+  fractional parts of the square roots of the 9th through 16th primes
+*/
+const uint32_t sha224StartingState[8] = {0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+                                         0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4};
 
-  // Generates the first 64 primes and uses the fractional bits of the cube
-  // roots of these primes to create our constants and the fractional portion
-  // of their square roots for the starting states of the registers
+const Sha224Traits::Word *Sha224Traits::startingState() {
+  return sha224StartingState;
+}
 
-  // Calculate cube root of 2 and retrieve the constant
-  data.input = cbrt(2.0);
+template class MerkleDamgardCtx<Sha224Traits>;
 
-  bitset<sizeof(double) * CHAR_BIT> bits(data.output);
+string sha224(const void *data, size_t length) {
+  Sha224Ctx ctx;
+  ctx.update(data, length);
 
-  uint32_t val = 0;
-  int pos = 31;
-  for(int bitPos = 51; bitPos > 19; --bitPos) {
-    if (bits[bitPos] == 1)
-      val += 1l << pos;
+  return ctx.finalize();
+}
 
-    --pos;
-  }
+string sha224(string_view data) {
+  return sha224(data.data(), data.length());
+}
 
-  constArray[0] = val;
+Digest<28> sha224Digest(const void *data, size_t length) {
+  Sha224Ctx ctx;
+  ctx.update(data, length);
 
-  // Calculate the remaining 63 primes and their resulting constants and
-  // starting registers states
-  int tracker = 3;
-  int counter;
-  int num;
-  int constArrPos = 1;
-  int primeTrack = 1;
-  int registerTrack = 0;
+  return ctx.finalizeDigest();
+}
 
-  for(counter = 2; counter <= 64; ++tracker) {
-    for(num = 2; num < tracker; ++num)
-      if(tracker % num == 0)
-        break;
+Digest<28> sha224Digest(string_view data) {
+  return sha224Digest(data.data(), data.length());
+}
 
-    if(num == tracker) {
-      // Next prime found
-      ++primeTrack;
-
-      pos = 31;
-      data.input = cbrt((double)tracker);
-
-      bitset<sizeof(double) * CHAR_BIT> bits(data.output);
-
-      // Account for shifting bits as the integral portion
-      // (left of the decimal point) starts surpassing powers
-      // of 2
-      double temp;
-      modf(data.input, &temp);
-      int tempInt = (int)temp;
-      int expShift = 0;
-      while(tempInt > 1 << expShift) {
-        tempInt -= 1l << expShift;
-        ++expShift;
-      }
+vector<Digest<28>> sha224Batch(const string_view data[], size_t count) {
+  return sha256processBatch<28>(data, count, sha224StartingState);
+}
 
-      val = 0;
-      for(int bitPos = 51 - expShift; bitPos > 19 - expShift; --bitPos) {
-        if (bits[bitPos] == 1)
-          val += 1ul << pos;
+vector<Digest<28>> sha224Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-        --pos;
-      }
+  return sha224Batch(views.data(), views.size());
+}
 
-      constArray[constArrPos] = val;
-      ++constArrPos;
+/*---------------------------------------------------------------------------*/
+/*                           Begin SHA512 Section                            */
+/*---------------------------------------------------------------------------*/
 
-      ++counter;
-    }
-  }
+/*
+  SHA512 is fundamentally the same in it's design as SHA256, with the
+  following changes:
 
-  // Initialize starting register states. Since these values are based on the
-  // second set of 32 bits of the fractional portion of the square roots of
-  // the 9th through 16th primes, it's easier to set these manually.
-  registers[0] = 3238371032; // 0xc1059ed8
-  registers[1] = 914150663;  // 0x367cd507
-  registers[2] = 812702999;  // 0x3070dd17
-  registers[3] = 4144912697; // 0xf70e5939
-  registers[4] = 4290775857; // 0xffc00b31
-  registers[5] = 1750603025; // 0x68581511
-  registers[6] = 1694076839; // 0x64f98fa7
-  registers[7] = 3204075428; // 0xbefa4fa4
-}
-
-string sha224(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  unsigned long padLength = data.length() * 8; // Each character in the data is 8
-                                               // bits
-  unsigned long lengthHolder = padLength; // Saved for later to add to the end
-                                          // of the pad buffer
-
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (512 * (padLength / 512 + 1));
-
-  if(lengthHolder + 1 > padLength - 64)
-    padLength += 512;
-
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
-
-  // Zero out pad buffer
-  for(int fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
-
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  int padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
-
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  - Blocks are processed in 1024 bit chunks
+  - Initial register values and constants values are extended to 64 bits
+  - There are 80 rounds instead of 64
+  - The message schedule array has 80 64 bit words
+  - Shift and rotation amounts are different
+*/
+
+/*
+  The lower sigma 0 (σ0) function for SHA384 and SHA512, defined as follows:
+
+  Given a 64 bit number, create another 64 bit number by performing the following
+
+  Rotational Right Shift of 1 bit from the original number XORd with
+  Rotational Right Shift of 8 bits from the original number XORd with
+  Right Shift of 7 bits from the original number
+*/
+uint64_t lowerSigma0_512(uint64_t val) {
+  return rotationalRightShift64(val, 1) ^ rotationalRightShift64(val, 8) ^ (val >> 7);
+}
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+/*
+  The lower sigma 1 (σ1) function for SHA384 and SHA512, defined as follows:
 
-  // Fill pad with 0s until 64 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+  Given a 64 bit number, create another 64 bit number by performing the following
 
-  padPos = padLength - 1;
+  Rotational Right Shift of 19 bits from the original number XORd with
+  Rotational Right Shift of 61 bits from the original number XORd with
+  Right Shift of 6 bits from the original number
+*/
+uint64_t lowerSigma1_512(uint64_t val) {
+  return rotationalRightShift64(val, 19) ^ rotationalRightShift64(val, 61) ^ (val >> 6);
+}
+
+/*
+  The upper sigma 0 (Σ0) function for SHA384 and SHA512, defined as follows:
+
+  Given a 64 bit number, create another 64 bit number by performing the following
 
-  uint64_t val = lengthHolder;
-  uint64_t temp = 0;
+  Rotational Right Shift of 28 bits from the original number XORd with
+  Rotational Right Shift of 34 bits from the original number XORd with
+  Rotational Right Shift of 39 bits from the original number
+*/
+uint64_t upperSigma0_512(uint64_t val) {
+  return rotationalRightShift64(val, 28) ^ rotationalRightShift64(val, 34) ^ rotationalRightShift64(val, 39);
+}
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 63; ++bitPos) {
-    bool bit = val & (1l << bitPos);
+/*
+  The upper sigma 1 (Σ1) function for SHA384 and SHA512, defined as follows:
 
-    padBuffer[padPos] = bit;
+  Given a 64 bit number, create another 64 bit number by performing the following
 
-    if(bit) {
-      temp += 1l << bitPos;
-      if(temp == val)
-        break;
-    }
+  Rotational Right Shift of 14 bits from the original number XORd with
+  Rotational Right Shift of 18 bits from the original number XORd with
+  Rotational Right Shift of 41 bits from the original number
+*/
+uint64_t upperSigma1_512(uint64_t val) {
+  return rotationalRightShift64(val, 14) ^ rotationalRightShift64(val, 18) ^ rotationalRightShift64(val, 41);
+}
 
-    --padPos;
+void generateSchedule512(const uint8_t block[128], uint64_t schedule[80]) {
+  // Create the first 16 64-bit words using the message block
+  for(short schedulePos = 0; schedulePos < 16; ++schedulePos)
+    schedule[schedulePos] = loadBigEndian64(block + schedulePos * 8);
+
+  // Expand the schedule to 80 64-bit words
+  for(short schedulePos = 16; schedulePos < 80; ++schedulePos)
+    schedule[schedulePos] = lowerSigma1_512(schedule[schedulePos - 2]) + schedule[schedulePos - 7] +
+                            lowerSigma0_512(schedule[schedulePos - 15]) + schedule[schedulePos - 16];
+}
+
+// Constants used by every SHA512 based algorithm, taken from the first 64 bits
+// of the fractional parts of the cube roots of the first 80 primes
+const uint64_t sha512Constants[80] = {0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
+                                      0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
+                                      0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
+                                      0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+                                      0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+                                      0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+                                      0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
+                                      0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+                                      0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
+                                      0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+                                      0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
+                                      0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+                                      0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
+                                      0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+                                      0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+                                      0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+                                      0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
+                                      0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+                                      0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
+                                      0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+                                      0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
+                                      0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
+                                      0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
+                                      0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+                                      0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+                                      0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+                                      0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+// Starting register states for SHA512, taken from the first 64 bits of the
+// fractional parts of the square roots of the first 8 primes
+const uint64_t sha512StartingState[8] = {0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+                                          0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+                                          0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+
+/*
+  A single round, defined as follows:
+
+  temp1 = H + upperSigma1(E) + choice(E, F, G) + scheduledWord
+  temp2 = upperSigma0(A) + majority(A, B, C)
+  D = D + temp1
+  H = temp1 + temp2
+
+  Instead of shifting every register to the right after each round, the
+  caller rotates the roles of the registers. All additions are taken modulo
+  2^64 through unsigned overflow.
+*/
+inline void sha512Round(uint64_t a, uint64_t b, uint64_t c, uint64_t &d,
+                        uint64_t e, uint64_t f, uint64_t g, uint64_t &h, uint64_t scheduledWord) {
+  uint64_t temp1 = h + upperSigma1_512(e) + choice64(e, f, g) + scheduledWord;
+
+  d += temp1;
+  h = temp1 + upperSigma0_512(a) + majority64(a, b, c);
+}
+
+/*
+  Runs the 80 rounds over a message schedule that already has the round
+  constants added on, then adds the result onto the registers
+
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
+*/
+inline void sha512compressRounds(uint64_t registers[8], const uint64_t scheduledWords[80]) {
+  uint64_t a = registers[0];
+  uint64_t b = registers[1];
+  uint64_t c = registers[2];
+  uint64_t d = registers[3];
+  uint64_t e = registers[4];
+  uint64_t f = registers[5];
+  uint64_t g = registers[6];
+  uint64_t h = registers[7];
+
+  for(short word = 0; word < 80; word += 8) {
+    sha512Round(a, b, c, d, e, f, g, h, scheduledWords[word]);
+    sha512Round(h, a, b, c, d, e, f, g, scheduledWords[word + 1]);
+    sha512Round(g, h, a, b, c, d, e, f, scheduledWords[word + 2]);
+    sha512Round(f, g, h, a, b, c, d, e, scheduledWords[word + 3]);
+    sha512Round(e, f, g, h, a, b, c, d, scheduledWords[word + 4]);
+    sha512Round(d, e, f, g, h, a, b, c, scheduledWords[word + 5]);
+    sha512Round(c, d, e, f, g, h, a, b, scheduledWords[word + 6]);
+    sha512Round(b, c, d, e, f, g, h, a, scheduledWords[word + 7]);
   }
 
-  // Create constants array and initial state registers
-  uint32_t constants[64];
-  uint32_t stateRegisters[8];
-  generateStartingHashState224(constants, stateRegisters);
-
-  // Process pad buffer in 512 bit blocks
-  bool block[512];
-
-  int blockTrack = 0;
-  uint32_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 512) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint32_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      // SHA224 and 256 process their blocks the same
-      sha256processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      unsigned long tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 31; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-
-          if(registerStateSave[pointer] & (1l << bitPos))
-            tempVal += 1l << bitPos;
-        }
+  // Add the processed registers onto the saved register state to obtain the
+  // final resulting register state of the current iteration
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+  registers[5] += f;
+  registers[6] += g;
+  registers[7] += h;
+}
+
+void sha512processBlockPortable(const uint8_t block[128], uint64_t registers[8], const uint64_t constants[80]) {
+  /* Create message schedule */
+  uint64_t schedule[80];
+
+  generateSchedule512(block, schedule);
+
+  for(short word = 0; word < 80; ++word)
+    schedule[word] += constants[word];
+
+  /* Begin compression process */
+  sha512compressRounds(registers, schedule);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Rotates each 64 bit lane right by count bits
+template<unsigned int count>
+__attribute__((target("ssse3")))
+inline __m128i rotationalRightShift2x64SSSE3(__m128i val) {
+  return _mm_or_si128(_mm_srli_epi64(val, count), _mm_slli_epi64(val, 64 - count));
+}
 
-        uint32_t newStateVal = tempVal % 4294967296;
+/*
+  Expands the next two schedule words from the previous sixteen, held in
+  order in words0 through words7, stores them with their round constants
+  added on and moves the window along. Neither new word depends on the
+  other, so unlike SHA256 no group needs finishing in halves.
+*/
+__attribute__((target("ssse3")))
+inline void expandScheduleSHA512x2(__m128i &words0, __m128i &words1, __m128i &words2, __m128i &words3,
+                                   __m128i &words4, __m128i &words5, __m128i &words6, __m128i &words7,
+                                   uint64_t scheduledWords[2], const uint64_t constants[2]) {
+  __m128i words15 = _mm_alignr_epi8(words1, words0, 8);
+  __m128i words7Back = _mm_alignr_epi8(words5, words4, 8);
+
+  __m128i lowerSigma0 = _mm_xor_si128(_mm_xor_si128(rotationalRightShift2x64SSSE3<1>(words15),
+                                                    rotationalRightShift2x64SSSE3<8>(words15)),
+                                      _mm_srli_epi64(words15, 7));
+  __m128i lowerSigma1 = _mm_xor_si128(_mm_xor_si128(rotationalRightShift2x64SSSE3<19>(words7),
+                                                    rotationalRightShift2x64SSSE3<61>(words7)),
+                                      _mm_srli_epi64(words7, 6));
+
+  __m128i next = _mm_add_epi64(_mm_add_epi64(words0, lowerSigma0), _mm_add_epi64(words7Back, lowerSigma1));
+
+  words0 = words1;
+  words1 = words2;
+  words2 = words3;
+  words3 = words4;
+  words4 = words5;
+  words5 = words6;
+  words6 = words7;
+  words7 = next;
+
+  _mm_store_si128((__m128i *)scheduledWords, _mm_add_epi64(next, _mm_loadu_si128((const __m128i *)constants)));
+}
 
-        stateRegisters[pointer] = newStateVal;
+/*
+  Single stream SHA512 with the message schedule expanded two words at a
+  time in vector registers, alongside the rounds on the scalar unit, in the
+  same way as SHA256's
+*/
+__attribute__((target("ssse3")))
+void sha512processBlockSSSE3(const uint8_t block[128], uint64_t registers[8], const uint64_t constants[80]) {
+  // Reverses the bytes of each word, turning big endian words into native ones
+  const __m128i byteSwap = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  /* Create the first 16 words of the message schedule */
+  alignas(16) uint64_t schedule[80];
+  __m128i words[8];
+
+  for(short pos = 0; pos < 8; ++pos) {
+    words[pos] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + pos * 16)), byteSwap);
+    _mm_store_si128((__m128i *)(schedule + pos * 2),
+                    _mm_add_epi64(words[pos], _mm_loadu_si128((const __m128i *)(constants + pos * 2))));
+  }
 
-        tempVal = 0;
-      }
+  __m128i words0 = words[0];
+  __m128i words1 = words[1];
+  __m128i words2 = words[2];
+  __m128i words3 = words[3];
+  __m128i words4 = words[4];
+  __m128i words5 = words[5];
+  __m128i words6 = words[6];
+  __m128i words7 = words[7];
 
-      blockTrack = 0;
-    }
+  /* Begin compression process */
+  uint64_t a = registers[0];
+  uint64_t b = registers[1];
+  uint64_t c = registers[2];
+  uint64_t d = registers[3];
+  uint64_t e = registers[4];
+  uint64_t f = registers[5];
+  uint64_t g = registers[6];
+  uint64_t h = registers[7];
+
+  for(short word = 0; word < 64; word += 8) {
+    expandScheduleSHA512x2(words0, words1, words2, words3, words4, words5, words6, words7,
+                           schedule + word + 16, constants + word + 16);
+    sha512Round(a, b, c, d, e, f, g, h, schedule[word]);
+    sha512Round(h, a, b, c, d, e, f, g, schedule[word + 1]);
+
+    expandScheduleSHA512x2(words0, words1, words2, words3, words4, words5, words6, words7,
+                           schedule + word + 18, constants + word + 18);
+    sha512Round(g, h, a, b, c, d, e, f, schedule[word + 2]);
+    sha512Round(f, g, h, a, b, c, d, e, schedule[word + 3]);
+
+    expandScheduleSHA512x2(words0, words1, words2, words3, words4, words5, words6, words7,
+                           schedule + word + 20, constants + word + 20);
+    sha512Round(e, f, g, h, a, b, c, d, schedule[word + 4]);
+    sha512Round(d, e, f, g, h, a, b, c, schedule[word + 5]);
+
+    expandScheduleSHA512x2(words0, words1, words2, words3, words4, words5, words6, words7,
+                           schedule + word + 22, constants + word + 22);
+    sha512Round(c, d, e, f, g, h, a, b, schedule[word + 6]);
+    sha512Round(b, c, d, e, f, g, h, a, schedule[word + 7]);
   }
 
-  /* Convert resulting state registers to hexadecimal notation */
+  // The last 16 words are already expanded
+  for(short word = 64; word < 80; word += 8) {
+    sha512Round(a, b, c, d, e, f, g, h, schedule[word]);
+    sha512Round(h, a, b, c, d, e, f, g, schedule[word + 1]);
+    sha512Round(g, h, a, b, c, d, e, f, schedule[word + 2]);
+    sha512Round(f, g, h, a, b, c, d, e, schedule[word + 3]);
+    sha512Round(e, f, g, h, a, b, c, d, schedule[word + 4]);
+    sha512Round(d, e, f, g, h, a, b, c, schedule[word + 5]);
+    sha512Round(c, d, e, f, g, h, a, b, schedule[word + 6]);
+    sha512Round(b, c, d, e, f, g, h, a, schedule[word + 7]);
+  }
 
-  return hexDigest(stateRegisters, 7);
+  // Add the processed registers onto the saved register state
+  registers[0] += a;
+  registers[1] += b;
+  registers[2] += c;
+  registers[3] += d;
+  registers[4] += e;
+  registers[5] += f;
+  registers[6] += g;
+  registers[7] += h;
 }
 
-/*---------------------------------------------------------------------------*/
-/*                           Begin SHA512 Section                            */
-/*---------------------------------------------------------------------------*/
+#endif
 
 /*
-  SHA512 is fundamentally the same in it's design as SHA256, with the
-  following changes:
+  Compresses a single block with the best kernel for the CPU, picked once at
+  startup by selectKernels(): the vectorized schedule where the CPU has SSSE3
 
-  - Blocks are processed in 1024 bit chunks
-  - Initial register values and constants values are extended to 64 bits
-  - There are 80 rounds instead of 64
-  - The message schedule array has 80 64 bit words
-  - Shift and rotation amounts are different
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
 */
+void (*sha512processBlock)(const uint8_t block[128], uint64_t registers[8],
+                           const uint64_t constants[80]) = sha512processBlockPortable;
 
-/*
-  The lower sigma 0 (σ0) function for SHA384 and SHA512, defined as follows:
+#if defined(__x86_64__) || defined(__i386__)
 
-  Given a 64 bit number, create another 64 bit number by performing the following
+/*
+  Multi-buffer SHA512 compression, running one block from each of 4 (AVX2)
+  or 8 (AVX-512) independent messages side by side, one message per 64 bit
+  lane
 
-  Rotational Right Shift of 1 bit from the original number XORd with
-  Rotational Right Shift of 8 bits from the original number XORd with
-  Right Shift of 7 bits from the original number
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
 */
-void lowerSigma0_512(bool word[64], uint64_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 1 time
-  bool tempWord1[64];
-  rotationalRightShift64(tempWord1, val, 1);
-
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 8 times
-  bool tempWord2[64];
-  rotationalRightShift64(tempWord2, val, 8);
-
-  // Temp word 3 is the result of a right shift of 7
-  bool tempWord3[64];
-  uint64_t tempVal = val >> 7;
-  short wordPos = 0;
-  for(short bitPos = 63; bitPos >= 0; --bitPos) {
-    bool bit = tempVal & (1ull << bitPos);
-
-    tempWord3[wordPos++] = bit;
+__attribute__((target("avx2")))
+void sha512processBlocks4AVX2(const uint8_t *blocks[4], uint64_t state[8][4], const uint64_t constants[80]) {
+  const __m256i byteSwap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                            7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  /* Create the first 16 words of the message schedule */
+  __m256i schedule[16];
+
+  // Transpose 4 words from each lane at a time into the same word of every
+  // lane, swapping the bytes of each from big endian
+  for(short quarter = 0; quarter < 4; ++quarter) {
+    __m256i rows[4];
+    for(short lane = 0; lane < 4; ++lane)
+      rows[lane] = _mm256_loadu_si256((const __m256i *)(blocks[lane] + quarter * 32));
+
+    __m256i low01 = _mm256_unpacklo_epi64(rows[0], rows[1]);
+    __m256i high01 = _mm256_unpackhi_epi64(rows[0], rows[1]);
+    __m256i low23 = _mm256_unpacklo_epi64(rows[2], rows[3]);
+    __m256i high23 = _mm256_unpackhi_epi64(rows[2], rows[3]);
+
+    __m256i *words = schedule + quarter * 4;
+    words[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(low01, low23, 0x20), byteSwap);
+    words[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(high01, high23, 0x20), byteSwap);
+    words[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(low01, low23, 0x31), byteSwap);
+    words[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(high01, high23, 0x31), byteSwap);
   }
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 64; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
-}
-
-/*
-  The lower sigma 1 (σ1) function for SHA384 and SHA512, defined as follows:
+  /* Begin compression process */
+  __m256i registers[8];
+  for(short pos = 0; pos < 8; ++pos)
+    registers[pos] = _mm256_load_si256((const __m256i *)state[pos]);
+
+  __m256i a = registers[0];
+  __m256i b = registers[1];
+  __m256i c = registers[2];
+  __m256i d = registers[3];
+  __m256i e = registers[4];
+  __m256i f = registers[5];
+  __m256i g = registers[6];
+  __m256i h = registers[7];
 
-  Given a 64 bit number, create another 64 bit number by performing the following
+  for(short word = 0; word < 80; ++word) {
+    // Expand the schedule in place, keeping only the last 16 words
+    if(word >= 16) {
+      __m256i word2 = schedule[(word - 2) & 15];
+      __m256i word15 = schedule[(word - 15) & 15];
+
+      __m256i lowerSigma1 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift4x64(word2, 19),
+                                                              rotationalRightShift4x64(word2, 61)),
+                                             _mm256_srli_epi64(word2, 6));
+      __m256i lowerSigma0 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift4x64(word15, 1),
+                                                              rotationalRightShift4x64(word15, 8)),
+                                             _mm256_srli_epi64(word15, 7));
+
+      schedule[word & 15] = _mm256_add_epi64(_mm256_add_epi64(schedule[word & 15], lowerSigma1),
+                                             _mm256_add_epi64(schedule[(word - 7) & 15], lowerSigma0));
+    }
 
-  Rotational Right Shift of 19 bits from the original number XORd with
-  Rotational Right Shift of 61 bits from the original number XORd with
-  Right Shift of 6 bits from the original number
-*/
-void lowerSigma1_512(bool word[64], uint64_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 19 times
-  bool tempWord1[64];
-  rotationalRightShift64(tempWord1, val, 19);
-
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 61 times
-  bool tempWord2[64];
-  rotationalRightShift64(tempWord2, val, 61);
-
-  // Temp word 3 is the result of a right shift of 6
-  bool tempWord3[64];
-  uint64_t tempVal = val >> 6;
-  short wordPos = 0;
-  for(short bitPos = 63; bitPos >= 0; --bitPos) {
-    bool bit = tempVal & (1ull << bitPos);
-
-    tempWord3[wordPos++] = bit;
+    __m256i upperSigma1 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift4x64(e, 14),
+                                                            rotationalRightShift4x64(e, 18)),
+                                           rotationalRightShift4x64(e, 41));
+    __m256i upperSigma0 = _mm256_xor_si256(_mm256_xor_si256(rotationalRightShift4x64(a, 28),
+                                                            rotationalRightShift4x64(a, 34)),
+                                           rotationalRightShift4x64(a, 39));
+
+    __m256i choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+
+    __m256i temp1 = _mm256_add_epi64(_mm256_add_epi64(h, upperSigma1),
+                                     _mm256_add_epi64(_mm256_add_epi64(choice, schedule[word & 15]),
+                                                      _mm256_set1_epi64x(constants[word])));
+    __m256i temp2 = _mm256_add_epi64(upperSigma0, majority);
+
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi64(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi64(temp1, temp2);
   }
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 64; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
+  // Add the processed registers onto the saved register state
+  _mm256_store_si256((__m256i *)state[0], _mm256_add_epi64(registers[0], a));
+  _mm256_store_si256((__m256i *)state[1], _mm256_add_epi64(registers[1], b));
+  _mm256_store_si256((__m256i *)state[2], _mm256_add_epi64(registers[2], c));
+  _mm256_store_si256((__m256i *)state[3], _mm256_add_epi64(registers[3], d));
+  _mm256_store_si256((__m256i *)state[4], _mm256_add_epi64(registers[4], e));
+  _mm256_store_si256((__m256i *)state[5], _mm256_add_epi64(registers[5], f));
+  _mm256_store_si256((__m256i *)state[6], _mm256_add_epi64(registers[6], g));
+  _mm256_store_si256((__m256i *)state[7], _mm256_add_epi64(registers[7], h));
 }
 
 /*
-  The upper sigma 0 (Σ0) function for SHA384 and SHA512, defined as follows:
+  Rotates and shifts each 64 bit lane right by count bits. These use the
+  masked forms with every lane selected, as the unmasked intrinsics pass
+  undefined registers through, which GCC 12 warns about as uninitialised
+*/
+template<unsigned int count>
+__attribute__((target("avx512f")))
+inline __m512i rotationalRightShift8x64AVX512(__m512i val) {
+  return _mm512_maskz_ror_epi64(0xff, val, count);
+}
 
-  Given a 64 bit number, create another 64 bit number by performing the following
+template<unsigned int count>
+__attribute__((target("avx512f")))
+inline __m512i rightShift8x64AVX512(__m512i val) {
+  return _mm512_maskz_srli_epi64(0xff, val, count);
+}
 
-  Rotational Right Shift of 28 bits from the original number XORd with
-  Rotational Right Shift of 34 bits from the original number XORd with
-  Rotational Right Shift of 39 bits from the original number
+/*
+  The AVX-512 version gathers each schedule word straight from the 8 blocks,
+  and has native rotations and three input logic for choice and majority
 */
-void upperSigma0_512(bool word[64], uint64_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 2 times
-  bool tempWord1[64];
-  rotationalRightShift64(tempWord1, val, 28);
+__attribute__((target("avx512f,avx512bw")))
+void sha512processBlocks8AVX512(const uint8_t *blocks[8], uint64_t state[8][8], const uint64_t constants[80]) {
+  const __m512i byteSwap = _mm512_set4_epi64(0x08090a0b0c0d0e0f, 0x0001020304050607,
+                                             0x08090a0b0c0d0e0f, 0x0001020304050607);
+
+  /* Create the first 16 words of the message schedule */
+  __m512i schedule[16];
+  // Widened one at a time, as pointers are only 4 bytes on 32 bit builds
+  __m512i addresses = _mm512_set_epi64((uint64_t)(uintptr_t)blocks[7], (uint64_t)(uintptr_t)blocks[6],
+                                       (uint64_t)(uintptr_t)blocks[5], (uint64_t)(uintptr_t)blocks[4],
+                                       (uint64_t)(uintptr_t)blocks[3], (uint64_t)(uintptr_t)blocks[2],
+                                       (uint64_t)(uintptr_t)blocks[1], (uint64_t)(uintptr_t)blocks[0]);
+
+  for(short word = 0; word < 16; ++word) {
+    __m512i words = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xff, addresses,
+                                                (const void *)(uintptr_t)(word * 8), 1);
+    schedule[word] = _mm512_shuffle_epi8(words, byteSwap);
+  }
+
+  /* Begin compression process */
+  __m512i registers[8];
+  for(short pos = 0; pos < 8; ++pos)
+    registers[pos] = _mm512_load_si512(state[pos]);
+
+  __m512i a = registers[0];
+  __m512i b = registers[1];
+  __m512i c = registers[2];
+  __m512i d = registers[3];
+  __m512i e = registers[4];
+  __m512i f = registers[5];
+  __m512i g = registers[6];
+  __m512i h = registers[7];
 
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 13 times
-  bool tempWord2[64];
-  rotationalRightShift64(tempWord2, val, 34);
+  for(short word = 0; word < 80; ++word) {
+    // Expand the schedule in place, keeping only the last 16 words
+    if(word >= 16) {
+      __m512i word2 = schedule[(word - 2) & 15];
+      __m512i word15 = schedule[(word - 15) & 15];
+
+      __m512i lowerSigma1 = _mm512_ternarylogic_epi64(rotationalRightShift8x64AVX512<19>(word2),
+                                                      rotationalRightShift8x64AVX512<61>(word2),
+                                                      rightShift8x64AVX512<6>(word2), 0x96);
+      __m512i lowerSigma0 = _mm512_ternarylogic_epi64(rotationalRightShift8x64AVX512<1>(word15),
+                                                      rotationalRightShift8x64AVX512<8>(word15),
+                                                      rightShift8x64AVX512<7>(word15), 0x96);
+
+      schedule[word & 15] = _mm512_add_epi64(_mm512_add_epi64(schedule[word & 15], lowerSigma1),
+                                             _mm512_add_epi64(schedule[(word - 7) & 15], lowerSigma0));
+    }
 
-  // Temp word 3 is the resulting word from performing a rotational right
-  // shift on originally passed word 22 times
-  bool tempWord3[64];
-  rotationalRightShift64(tempWord3, val, 39);
+    __m512i upperSigma1 = _mm512_ternarylogic_epi64(rotationalRightShift8x64AVX512<14>(e), rotationalRightShift8x64AVX512<18>(e),
+                                                    rotationalRightShift8x64AVX512<41>(e), 0x96);
+    __m512i upperSigma0 = _mm512_ternarylogic_epi64(rotationalRightShift8x64AVX512<28>(a), rotationalRightShift8x64AVX512<34>(a),
+                                                    rotationalRightShift8x64AVX512<39>(a), 0x96);
+
+    __m512i choice = _mm512_ternarylogic_epi64(e, f, g, 0xca);
+    __m512i majority = _mm512_ternarylogic_epi64(a, b, c, 0xe8);
+
+    __m512i temp1 = _mm512_add_epi64(_mm512_add_epi64(h, upperSigma1),
+                                     _mm512_add_epi64(_mm512_add_epi64(choice, schedule[word & 15]),
+                                                      _mm512_set1_epi64(constants[word])));
+    __m512i temp2 = _mm512_add_epi64(upperSigma0, majority);
+
+    h = g;
+    g = f;
+    f = e;
+    e = _mm512_add_epi64(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm512_add_epi64(temp1, temp2);
+  }
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 64; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
+  // Add the processed registers onto the saved register state
+  _mm512_store_si512(state[0], _mm512_add_epi64(registers[0], a));
+  _mm512_store_si512(state[1], _mm512_add_epi64(registers[1], b));
+  _mm512_store_si512(state[2], _mm512_add_epi64(registers[2], c));
+  _mm512_store_si512(state[3], _mm512_add_epi64(registers[3], d));
+  _mm512_store_si512(state[4], _mm512_add_epi64(registers[4], e));
+  _mm512_store_si512(state[5], _mm512_add_epi64(registers[5], f));
+  _mm512_store_si512(state[6], _mm512_add_epi64(registers[6], g));
+  _mm512_store_si512(state[7], _mm512_add_epi64(registers[7], h));
 }
 
-/*
-  The upper sigma 1 (Σ1) function for SHA384 and SHA512, defined as follows:
+#endif
 
-  Given a 64 bit number, create another 64 bit number by performing the following
+/*
+  Hashes every message of a batch, keeping the first digestSize bytes of each
+  result. Messages are run 8 at a time with AVX-512, 4 at a time with AVX2,
+  or otherwise one after another.
 
-  Rotational Right Shift of 14 bits from the original number XORd with
-  Rotational Right Shift of 18 bits from the original number XORd with
-  Rotational Right Shift of 41 bits from the original number
+  Used in:
+  - SHA384, SHA512, SHA512/224, SHA512/256
 */
-void upperSigma1_512(bool word[64], uint64_t val) {
-  // Temp word 1 is the resulting word from performing a rotational right
-  // shift on originally passed word 6 times
-  bool tempWord1[64];
-  rotationalRightShift64(tempWord1, val, 14);
-
-  // Temp word 2 is the resulting word from performing a rotational right
-  // shift on originally passed word 11 times
-  bool tempWord2[64];
-  rotationalRightShift64(tempWord2, val, 18);
+template<size_t digestSize>
+vector<Digest<digestSize>> sha512processBatch(const string_view data[], size_t count,
+                                              const uint64_t startingState[8]) {
+  vector<Digest<digestSize>> digests(count);
+
+  auto store = [&digests](size_t message, const uint64_t registers[]) {
+    for(size_t pos = 0; pos < digestSize; ++pos)
+      digests[message][pos] = (registers[pos / 8] >> (56 - 8 * (pos % 8))) & 255;
+  };
+
+#if defined(__x86_64__) || defined(__i386__)
+  short lanes = calibratedBatchLanes(batchSha512, data, count);
+
+  if(cpuHasAVX512 && (lanes == 0 || lanes == 8)) {
+    auto kernel = [](const uint8_t *blocks[], uint64_t state[][8]) {
+      sha512processBlocks8AVX512(blocks, state, sha512Constants);
+    };
+
+    hashBatch<uint64_t, 8, 8, 128, 16, true>(data, count, startingState, kernel, store);
+    return digests;
+  }
 
-  // Temp word 3 is the resulting word from performing a rotational right
-  // shift on originally passed word 25 times
-  bool tempWord3[64];
-  rotationalRightShift64(tempWord3, val, 41);
+  if(cpuHasAVX2 && (lanes == 0 || lanes == 4)) {
+    auto kernel = [](const uint8_t *blocks[], uint64_t state[][4]) {
+      sha512processBlocks4AVX2(blocks, state, sha512Constants);
+    };
 
-  // Resulting word comes from XORing all 3 generated temporary words
-  for(short bitPos = 0; bitPos < 64; ++bitPos)
-    word[bitPos] = tempWord1[bitPos] ^ tempWord2[bitPos] ^ tempWord3[bitPos];
-}
+    hashBatch<uint64_t, 4, 8, 128, 16, true>(data, count, startingState, kernel, store);
+    return digests;
+  }
+#endif
 
-void generateSchedule512(bool block[1024], uint64_t schedule[80]) {
-  // Create the first 16 64-bit words using the message block
-  short bitCount = 0;
-  short schedulePos = 0;
-  short bitPos = 63;
-  bool word[64];
-  for(int blockCount = 0; blockCount < 1024; ++blockCount) {
-    word[bitCount] = block[blockCount];
-    ++bitCount;
-
-    if(bitCount == 64) {
-      uint64_t val = 0;
-
-      for (bool wordBit: word) {
-        if (wordBit)
-          val += 1l << bitPos;
-        --bitPos;
-      }
+  auto kernel = [](const uint8_t *blocks[], uint64_t state[][1]) {
+    uint64_t registers[8];
+    for(short pos = 0; pos < 8; ++pos)
+      registers[pos] = state[pos][0];
 
-      schedule[schedulePos] = val;
-      ++schedulePos;
+    sha512processBlock(blocks[0], registers, sha512Constants);
 
-      bitCount = 0;
-      bitPos = 63;
-    }
-  }
+    for(short pos = 0; pos < 8; ++pos)
+      state[pos][0] = registers[pos];
+  };
 
-  // Expand the schedule to 80 64-bit words
-  while(schedulePos < 80) {
-    bool word1[64];
-    lowerSigma0_512(word1, schedule[schedulePos - 15]);
-
-    bool word2[64];
-    lowerSigma1_512(word2, schedule[schedulePos - 2]);
-
-    short wordPos = 0;
-    bool word3[64];
-    uint64_t val = schedule[schedulePos - 7];
-    while (bitPos >= 0) {
-      word3[wordPos] = val & (1ull << bitPos);
-      ++wordPos;
-      --bitPos;
-    }
+  hashBatch<uint64_t, 1, 8, 128, 16, true>(data, count, startingState, kernel, store);
+  return digests;
+}
 
-    bitPos = 63;
-    wordPos = 0;
-    bool word4[64];
-    val = schedule[schedulePos - 16];
-    while (bitPos >= 0) {
-      word4[wordPos] = val & (1ull << bitPos);
-      ++wordPos;
-      --bitPos;
-    }
+const Sha512Traits::Word *Sha512Traits::startingState() {
+  return sha512StartingState;
+}
 
-    bitPos = 63;
+void Sha512Traits::processBlock(const uint8_t block[], Word registers[]) {
+  sha512processBlock(block, registers, sha512Constants);
+}
 
-    // Add them all and take the result mod 2^64
-    uint128_t tempValue = 0;
-    short bitTrack = 0;
-    for (short bitPos = 63; bitPos >= 0; --bitPos) {
-      if(word1[bitPos])
-        tempValue += 1ull << bitTrack;
+template class MerkleDamgardCtx<Sha512Traits>;
 
-      if(word2[bitPos])
-        tempValue += 1ull << bitTrack;
+string sha512(const void *data, size_t length) {
+  Sha512Ctx ctx;
+  ctx.update(data, length);
 
-      if(word3[bitPos])
-        tempValue += 1ull << bitTrack;
+  return ctx.finalize();
+}
 
-      if(word4[bitPos])
-        tempValue += 1ull << bitTrack;
+string sha512(string_view data) {
+  return sha512(data.data(), data.length());
+}
 
-      ++bitTrack;
-    }
+Digest<64> sha512Digest(const void *data, size_t length) {
+  Sha512Ctx ctx;
+  ctx.update(data, length);
 
-    uint64_t scheduleWord = tempValue % bigModulo;
+  return ctx.finalizeDigest();
+}
 
-    schedule[schedulePos] = scheduleWord;
-    ++schedulePos;
-  }
+Digest<64> sha512Digest(string_view data) {
+  return sha512Digest(data.data(), data.length());
 }
 
-void sha512processBlock(bool block[1024], uint64_t registers[8], uint64_t constants[80]) {
-  /* Create message schedule */
-  uint64_t schedule[80];
+vector<Digest<64>> sha512Batch(const string_view data[], size_t count) {
+  return sha512processBatch<64>(data, count, sha512StartingState);
+}
 
-  generateSchedule512(block, schedule);
+vector<Digest<64>> sha512Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-  /* Begin compression process */
-  for(short word = 0; word < 80; ++word) {
-    uint64_t scheduleWord = schedule[word];
-    uint64_t constantWord = constants[word];
-
-    /* Create first temporary word used to change state registers */
-
-    // Generate first temporary word using the resulting word from passing
-    // the word in the 5th register to the upper sigma 1 function
-    bool tempWord1[64];
-    upperSigma1_512(tempWord1, registers[4]);
-
-    // Generate second temporary word using the resulting word from passing
-    // the 5th, 6th and 7th registers to the choice function
-    bool tempWord2[64];
-    choice64(tempWord2, registers[4], registers[5], registers[6]);
-
-    // Temp word 3 is simply the 8th register, temp word 4 is the schedule word
-    // and temp word 5 is the constant word
-    uint64_t val = registers[7];
-    bool tempWord3[64];
-    bool tempWord4[64];
-    bool tempWord5[64];
-    short wordPos = 0;
-    for(short bitPos = 63; bitPos >= 0; --bitPos) {
-      tempWord3[bitPos] = val & (1ull << wordPos);
-      tempWord4[bitPos] = scheduleWord & (1ull << wordPos);
-      tempWord5[bitPos] = constantWord & (1ull << wordPos);
-
-      ++wordPos;
-    }
+  return sha512Batch(views.data(), views.size());
+}
 
-    // Add all words up taken at module 2^64 to get the first final temp word
-    uint128_t finTempVal = 0;
+/*---------------------------------------------------------------------------*/
+/*                           Begin SHA384 Section                            */
+/*---------------------------------------------------------------------------*/
 
-    short bitTrack = 0;
-    for(short bitPos = 63; bitPos >= 0; --bitPos) {
-      if(tempWord1[bitPos])
-        finTempVal += 1ull << bitTrack;
+/*
+  SHA384's algorithm design is exactly the same as SHA512's, with the
+  following changes:
 
-      if(tempWord2[bitPos])
-        finTempVal += 1ull << bitTrack;
+  - State registers are created using the 9th through 16th primes instead
+    of the first 8
+  - Output is generated by omitting the 7th and 8th state register's values
+*/
 
-      if(tempWord3[bitPos])
-        finTempVal += 1ull << bitTrack;
+const uint64_t sha384StartingState[8] = {0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17,
+                                         0x152fecd8f70e5939, 0x67332667ffc00b31, 0x8eb44a8768581511,
+                                         0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4};
 
-      if(tempWord4[bitPos])
-        finTempVal += 1ull << bitTrack;
+const Sha384Traits::Word *Sha384Traits::startingState() {
+  return sha384StartingState;
+}
 
-      if(tempWord5[bitPos])
-        finTempVal += 1ull << bitTrack;
+template class MerkleDamgardCtx<Sha384Traits>;
 
-      ++bitTrack;
-    }
+string sha384(const void *data, size_t length) {
+  Sha384Ctx ctx;
+  ctx.update(data, length);
 
-    uint64_t finalTemp1 = finTempVal % bigModulo;
+  return ctx.finalize();
+}
 
-    /* Create second temporary word used to change state registers */
+string sha384(string_view data) {
+  return sha384(data.data(), data.length());
+}
 
-    // Generate first temporary word using the resulting word from passing
-    // the word in the first register to the upper sigma 0 function
-    upperSigma0_512(tempWord1, registers[0]);
-    uint128_t val1 = 0;
-    bitTrack = 63;
-    for(bool bit: tempWord1) {
-      if(bit)
-        val1 += 1ull << bitTrack;
-      --bitTrack;
-    }
+Digest<48> sha384Digest(const void *data, size_t length) {
+  Sha384Ctx ctx;
+  ctx.update(data, length);
 
-    // Generate second temporary word using the resulting word from passing
-    // the 1st, 2nd and 3rd registers to the majority function
-    majority64(tempWord2, registers[0], registers[1], registers[2]);
-    uint128_t val2 = 0;
-    bitTrack = 63;
-    for(bool bit: tempWord2) {
-      if(bit)
-        val2 += 1ull << bitTrack;
-      --bitTrack;
-    }
+  return ctx.finalizeDigest();
+}
 
-    // Add all words up taken at module 2^64 to get the second final temp word
-    finTempVal = val1 + val2;
+Digest<48> sha384Digest(string_view data) {
+  return sha384Digest(data.data(), data.length());
+}
 
-    uint64_t finalTemp2 = finTempVal % bigModulo;
+vector<Digest<48>> sha384Batch(const string_view data[], size_t count) {
+  return sha512processBatch<48>(data, count, sha384StartingState);
+}
 
-    /* Update state registers */
+vector<Digest<48>> sha384Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-    // Shift register values to the right, discarding the value held in
-    // register 8
-    for(int iter = 7; iter > 0; --iter)
-      registers[iter] = registers[iter - 1];
+  return sha384Batch(views.data(), views.size());
+}
 
-    // Fill first register position with the result of adding together the two
-    // temporary words generated above taken modulo 2^64
-    finTempVal = 0;
-    for(short bitPos = 63; bitPos >= 0; --bitPos) {
-      if(finalTemp1 & (1ull << bitPos))
-        finTempVal += 1ull << bitPos;
+/*---------------------------------------------------------------------------*/
+/*                         Begin SHA512/224 Section                          */
+/*---------------------------------------------------------------------------*/
 
-      if(finalTemp2 & (1ull << bitPos))
-        finTempVal += 1ull << bitPos;
-    }
+/*
+  SHA512/224 is exactly the same as SHA512 and SHA384, accept for the
+  following changes:
 
-    uint64_t finalWord = finTempVal % bigModulo;
+  - State registers are determined by the result of the SHA512/t IV Generation
+    function on the string "SHA512/224".
+  - Output is truncated to 224 bits
+*/
 
-    registers[0] = finalWord;
+const uint64_t sha512_224StartingState[8] = {0x8c3d37c819544da2, 0x73e1996689dcd4d6, 0x1dfab7ae32ff9c82,
+                                             0x679dd514582f9fcf, 0x0f6d2b697bd44da8, 0x77e36f7304c48942,
+                                             0x3f9d85a86a1d36c8, 0x1112e6ad91d692a1};
 
-    // Switch register 5's value with the resulting word from adding together
-    // the 5th register value and the value of the first final temporary word
-    // generated above taken modulo 2^64
-    finTempVal = 0;
-    for(short bitPos = 63; bitPos >= 0; --bitPos) {
-      if(registers[4] & (1ull << bitPos))
-        finTempVal += 1ull << bitPos;
+const Sha512_224Traits::Word *Sha512_224Traits::startingState() {
+  return sha512_224StartingState;
+}
 
-      if(finalTemp1 & (1ull << bitPos))
-        finTempVal += 1ull << bitPos;
-    }
+template class MerkleDamgardCtx<Sha512_224Traits>;
 
-    finalWord = finTempVal % bigModulo;
+string sha512_224(const void *data, size_t length) {
+  Sha512_224Ctx ctx;
+  ctx.update(data, length);
 
-    registers[4] = finalWord;
-  }
+  return ctx.finalize();
 }
 
-string sha512(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  uint128_t padLength = data.length() * 8; // Each character in the data is 8
-                                           // bits
-  uint128_t lengthHolder = padLength; // Saved for later to add to the end
-                                      // of the pad buffer
+string sha512_224(string_view data) {
+  return sha512_224(data.data(), data.length());
+}
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (1024 * (padLength / 1024 + 1));
+Digest<28> sha512_224Digest(const void *data, size_t length) {
+  Sha512_224Ctx ctx;
+  ctx.update(data, length);
 
-  if(lengthHolder + 1 > padLength - 128)
-    padLength += 1024;
+  return ctx.finalizeDigest();
+}
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+Digest<28> sha512_224Digest(string_view data) {
+  return sha512_224Digest(data.data(), data.length());
+}
 
-  // Zero out pad buffer
-  for(uint128_t fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+vector<Digest<28>> sha512_224Batch(const string_view data[], size_t count) {
+  return sha512processBatch<28>(data, count, sha512_224StartingState);
+}
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  uint128_t padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+vector<Digest<28>> sha512_224Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  return sha512_224Batch(views.data(), views.size());
+}
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+/*---------------------------------------------------------------------------*/
+/*                         Begin SHA512/256 Section                          */
+/*---------------------------------------------------------------------------*/
 
-  // Fill pad with 0s until 128 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+/*
+  SHA512/224 is exactly the same as SHA512 and SHA384, accept for the
+  following changes:
 
-  padPos = padLength - 1;
+  - State registers are determined by the result of the SHA512/t IV Generation
+    function on the string "SHA512/256".
+  - Output is truncated to 256 bits
+*/
 
-  uint128_t val = lengthHolder;
-  uint128_t temp = 0;
+const uint64_t sha512_256StartingState[8] = {0x22312194fc2bf72c, 0x9f555fa3c84c64c2, 0x2393b86b6f53b151,
+                                             0x963877195940eabd, 0x96283ee2a88effe3, 0xbe5e1e2553863992,
+                                             0x2b0199fc2c85b8aa, 0x0eb72ddc81c52ca2};
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 127; ++bitPos) {
-    bool bit = val & ((uint128_t)1 << bitPos);
+const Sha512_256Traits::Word *Sha512_256Traits::startingState() {
+  return sha512_256StartingState;
+}
 
-    padBuffer[padPos] = bit;
+template class MerkleDamgardCtx<Sha512_256Traits>;
 
-    if(bit) {
-      temp += 1ull << bitPos;
-      if(temp == val)
-        break;
-    }
+string sha512_256(const void *data, size_t length) {
+  Sha512_256Ctx ctx;
+  ctx.update(data, length);
 
-    --padPos;
-  }
+  return ctx.finalize();
+}
 
-  // Create constants array and initial state registers
-  uint64_t constants[80] = {0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
-                            0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
-                            0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
-                            0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
-                            0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
-                            0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
-                            0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
-                            0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
-                            0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
-                            0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
-                            0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
-                            0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
-                            0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
-                            0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
-                            0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
-                            0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
-                            0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
-                            0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
-                            0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
-                            0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-                            0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
-                            0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
-                            0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
-                            0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
-                            0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
-                            0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
-                            0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
-  
-  uint64_t stateRegisters[8];
-  stateRegisters[0] = 7640891576956012808;  // 0x6a09e667f3bcc908
-  stateRegisters[1] = 13503953896175478587; // 0xbb67ae8584caa73b
-  stateRegisters[2] = 4354685564936845355;  // 0x3c6ef372fe94f82b
-  stateRegisters[3] = 11912009170470909681; // 0xa54ff53a5f1d36f1
-  stateRegisters[4] = 5840696475078001361;  // 0x510e527fade682d1
-  stateRegisters[5] = 11170449401992604703; // 0x9b05688c2b3e6c1f
-  stateRegisters[6] = 2270897969802886507;  // 0x1f83d9abfb41bd6b
-  stateRegisters[7] = 6620516959819538809;  // 0x5be0cd19137e2179
-
-  // Process pad buffer in 1024 bit blocks
-  bool block[1024];
-
-  int blockTrack = 0;
-  uint64_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 1024) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint64_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      sha512processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      uint128_t tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 63; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-
-          if(registerStateSave[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-        }
+string sha512_256(string_view data) {
+  return sha512_256(data.data(), data.length());
+}
 
-        uint64_t newStateVal = tempVal % bigModulo;
+Digest<32> sha512_256Digest(const void *data, size_t length) {
+  Sha512_256Ctx ctx;
+  ctx.update(data, length);
 
-        stateRegisters[pointer] = newStateVal;
+  return ctx.finalizeDigest();
+}
 
-        tempVal = 0;
-      }
+Digest<32> sha512_256Digest(string_view data) {
+  return sha512_256Digest(data.data(), data.length());
+}
 
-      blockTrack = 0;
-    }
-  }
+vector<Digest<32>> sha512_256Batch(const string_view data[], size_t count) {
+  return sha512processBatch<32>(data, count, sha512_256StartingState);
+}
 
-  /* Convert resulting state registers to hexadecimal notation */
+vector<Digest<32>> sha512_256Batch(const vector<string> &data) {
+  vector<string_view> views(data.begin(), data.end());
 
-  return hexDigest(stateRegisters, 8);
+  return sha512_256Batch(views.data(), views.size());
 }
 
 /*---------------------------------------------------------------------------*/
-/*                           Begin SHA384 Section                            */
+/*                          Begin SHA512/t Section                           */
 /*---------------------------------------------------------------------------*/
 
 /*
-  SHA384's algorithm design is exactly the same as SHA512's, with the
-  following changes:
+  SHA512/t is SHA512 with its output truncated to t bits and its state
+  registers set by the SHA512/t IV Generation Function described in FIPS 180-4:
 
-  - State registers are created using the 9th through 16th primes instead
-    of the first 8
-  - Output is generated by omitting the 7th and 8th state register's values
+  - SHA512's starting state is XORed with a5a5a5a5a5a5a5a5
+  - The string "SHA-512/t" is hashed with SHA512 using that state
+  - The resulting state registers become the starting state for SHA512/t
+
+  t is limited to whole bytes from 8 to 504 bits, excluding 384 which FIPS
+  180-4 reserves for SHA384.
 */
 
-string sha384(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  uint128_t padLength = data.length() * 8; // Each character in the data is 8
-                                           // bits
-  uint128_t lengthHolder = padLength; // Saved for later to add to the end
-                                      // of the pad buffer
+bool validSha512_t(int t) {
+  return t > 0 && t < 512 && t % 8 == 0 && t != 384;
+}
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (1024 * (padLength / 1024 + 1));
+void generateStartingHashState512_t(int t, uint64_t registers[8]) {
+  for(short pos = 0; pos < 8; ++pos)
+    registers[pos] = sha512StartingState[pos] ^ 0xa5a5a5a5a5a5a5a5;
 
-  if(lengthHolder + 1 > padLength - 128)
-    padLength += 1024;
+  // The name is at most 11 bytes, so its padding always fits in one block
+  string name = "SHA-512/" + to_string(t);
+  uint64_t lengthHolder = name.length() * 8;
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+  uint8_t block[128] = {};
+  memcpy(block, name.data(), name.length());
+  block[name.length()] = 128;
+  block[126] = (lengthHolder >> 8) & 255;
+  block[127] = lengthHolder & 255;
 
-  // Zero out pad buffer
-  for(uint128_t fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  sha512processBlock(block, registers, sha512Constants);
+}
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  uint128_t padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+/*
+  Starting states of every valid t, indexed by t / 8. They are generated the
+  first time any SHA512/t context is created, so afterwards a truncated hash
+  costs exactly as much as a full SHA512.
+*/
+struct StartingStates512_t {
+  uint64_t registers[64][8];
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
+  StartingStates512_t() {
+    for(int t = 8; t < 512; t += 8)
+      if(validSha512_t(t))
+        generateStartingHashState512_t(t, registers[t / 8]);
   }
+};
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+// Throws invalid_argument for any t that validSha512_t() rejects
+const uint64_t *startingHashState512_t(int t) {
+  if(!validSha512_t(t))
+    throw invalid_argument("SHA512/t requires t to be a multiple of 8 between 8 and 504, other than 384");
 
-  // Fill pad with 0s until 128 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+  static const StartingStates512_t states;
 
-  padPos = padLength - 1;
+  return states.registers[t / 8];
+}
+
+Sha512_tCtx::Sha512_tCtx(int t) : core(startingHashState512_t(t)) {
+  digestLength = t;
+}
 
-  uint128_t val = lengthHolder;
-  uint128_t temp = 0;
+void Sha512_tCtx::update(const void *data, size_t length) {
+  core.update(data, length);
+}
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 127; ++bitPos) {
-    bool bit = val & ((uint128_t)1 << bitPos);
+void Sha512_tCtx::update(string_view data) {
+  core.update(data);
+}
 
-    padBuffer[padPos] = bit;
+void Sha512_tCtx::finalizeDigest(uint8_t digest[]) {
+  Digest<64> full = core.finalizeDigest();
 
-    if(bit) {
-      temp += 1ull << bitPos;
-      if(temp == val)
-        break;
-    }
+  memcpy(digest, full.data(), digestLength / 8);
+}
 
-    --padPos;
-  }
+string Sha512_tCtx::finalize() {
+  uint8_t digest[64];
+  finalizeDigest(digest);
 
-  // Create constants array and initial state registers
-  uint64_t constants[80] = {0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
-                            0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
-                            0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
-                            0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
-                            0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
-                            0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
-                            0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
-                            0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
-                            0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
-                            0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
-                            0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
-                            0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
-                            0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
-                            0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
-                            0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
-                            0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
-                            0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
-                            0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
-                            0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
-                            0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-                            0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
-                            0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
-                            0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
-                            0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
-                            0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
-                            0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
-                            0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
-  
-  uint64_t stateRegisters[8];
-  stateRegisters[0] = 14680500436340154072; // 0xcbbb9d5dc1059ed8
-  stateRegisters[1] = 7105036623409894663;  // 0x629a292a367cd507
-  stateRegisters[2] = 10473403895298186519; // 0x9159015a3070dd17
-  stateRegisters[3] = 1526699215303891257;  // 0x152fecd8f70e5939
-  stateRegisters[4] = 7436329637833083697;  // 0x67332667ffc00b31
-  stateRegisters[5] = 10282925794625328401; // 0x8eb44a8768581511
-  stateRegisters[6] = 15784041429090275239; // 0xdb0c2e0d64f98fa7
-  stateRegisters[7] = 5167115440072839076;  // 0x47b5481dbefa4fa4
-
-  // Process pad buffer in 1024 bit blocks
-  bool block[1024];
-
-  int blockTrack = 0;
-  uint64_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 1024) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint64_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      sha512processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      uint128_t tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 63; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-
-          if(registerStateSave[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-        }
+  return hexDigest(digest, digestLength / 8);
+}
 
-        uint64_t newStateVal = tempVal % bigModulo;
+string sha512_t(const void *data, size_t length, int t) {
+  Sha512_tCtx ctx(t);
+  ctx.update(data, length);
 
-        stateRegisters[pointer] = newStateVal;
+  return ctx.finalize();
+}
 
-        tempVal = 0;
-      }
+string sha512_t(string_view data, int t) {
+  return sha512_t(data.data(), data.length(), t);
+}
 
-      blockTrack = 0;
-    }
-  }
+void sha512_tDigest(const void *data, size_t length, int t, uint8_t digest[]) {
+  Sha512_tCtx ctx(t);
+  ctx.update(data, length);
 
-  /* Convert resulting state registers to hexadecimal notation */
+  ctx.finalizeDigest(digest);
+}
 
-  return hexDigest(stateRegisters, 6);
+void sha512_tDigest(string_view data, int t, uint8_t digest[]) {
+  sha512_tDigest(data.data(), data.length(), t, digest);
 }
 
 /*---------------------------------------------------------------------------*/
-/*                         Begin SHA512/224 Section                          */
+/*                          Begin Dispatch Section                           */
 /*---------------------------------------------------------------------------*/
 
 /*
-  SHA512/224 is exactly the same as SHA512 and SHA384, accept for the
-  following changes:
+  Points every single block kernel above at the best implementation for the
+  CPU, within the tier forced by HASHES_CPU_TIER if any. The kernels start
+  out pointing at the portable code, so anything hashed before this runs at
+  startup still gets the right result. The batch functions check the same
+  cpuHas flags on each call, as they pick a lane count rather than a single
+  function.
+*/
+bool selectKernels() {
+#if defined(__x86_64__) || defined(__i386__)
+  if(cpuHasSSSE3)
+    sha0processBlock = sha1processBlockSSSE3<0>;
+
+  if(cpuHasShaExtensions)
+    sha1processBlock = sha1processBlockSHANI;
+  else if(cpuHasSSSE3)
+    sha1processBlock = sha1processBlockSSSE3<1>;
+
+  if(cpuHasShaExtensions)
+    sha256processBlock = sha256processBlockSHANI;
+  else if(cpuHasSSSE3)
+    sha256processBlock = sha256processBlockSSSE3;
+
+  if(cpuHasSSSE3)
+    sha512processBlock = sha512processBlockSSSE3;
+#endif
+
+  return true;
+}
 
-  - State registers are determined by the result of the SHA512/t IV Generation
-    function on the string "SHA512/224".
-  - Output is truncated to 224 bits
+const bool kernelsSelected = selectKernels();
+
+/*---------------------------------------------------------------------------*/
+/*                         Begin Calibration Section                         */
+/*---------------------------------------------------------------------------*/
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+  A single block kernel that calibrateKernels() can pick, along with the
+  names it goes by in the cache file
+*/
+struct KernelCandidate {
+  const char *algorithm;
+  const char *name;
+  bool available;
+  void (*install)();
+};
+
+/*
+  Algorithms with a choice of single block kernel, each hashing a message
+  through whichever kernel is currently installed
+*/
+struct KernelAlgorithm {
+  const char *name;
+  void (*hash)(const string &data);
+};
+
+const KernelAlgorithm kernelAlgorithms[] = {
+  {"sha0", [](const string &data) { Sha0Ctx ctx; ctx.update(data); ctx.finalizeDigest(); }},
+  {"sha1", [](const string &data) { Sha1Ctx ctx; ctx.update(data); ctx.finalizeDigest(); }},
+  {"sha256", [](const string &data) { Sha256Ctx ctx; ctx.update(data); ctx.finalizeDigest(); }},
+  {"sha512", [](const string &data) { Sha512Ctx ctx; ctx.update(data); ctx.finalizeDigest(); }},
+};
+
+vector<KernelCandidate> kernelCandidates() {
+  return {
+    {"sha0", "portable", true, [] { sha0processBlock = sha0processBlockPortable; }},
+    {"sha0", "ssse3", cpuHasSSSE3, [] { sha0processBlock = sha1processBlockSSSE3<0>; }},
+    {"sha1", "portable", true, [] { sha1processBlock = sha1processBlockPortable; }},
+    {"sha1", "ssse3", cpuHasSSSE3, [] { sha1processBlock = sha1processBlockSSSE3<1>; }},
+    {"sha1", "shani", cpuHasShaExtensions, [] { sha1processBlock = sha1processBlockSHANI; }},
+    {"sha256", "portable", true, [] { sha256processBlock = sha256processBlockPortable; }},
+    {"sha256", "ssse3", cpuHasSSSE3, [] { sha256processBlock = sha256processBlockSSSE3; }},
+    {"sha256", "shani", cpuHasShaExtensions, [] { sha256processBlock = sha256processBlockSHANI; }},
+    {"sha512", "portable", true, [] { sha512processBlock = sha512processBlockPortable; }},
+    {"sha512", "ssse3", cpuHasSSSE3, [] { sha512processBlock = sha512processBlockSSSE3; }},
+  };
+}
+
+/*
+  A batch function along with the lane counts it can run at on this CPU,
+  where 1 means one message after another through the single block kernel
 */
+struct BatchCandidates {
+  BatchAlgorithm algorithm;
+  const char *name;
+  void (*hash)(const vector<string> &data);
+  vector<short> lanes;
+};
+
+vector<BatchCandidates> batchCandidates() {
+  vector<BatchCandidates> candidates = {
+    {batchMd2, "md2", [](const vector<string> &data) { md2Batch(data); }, {1}},
+    {batchMd4, "md4", [](const vector<string> &data) { md4Batch(data); }, {1}},
+    {batchMd5, "md5", [](const vector<string> &data) { md5Batch(data); }, {1}},
+    {batchSha1, "sha1", [](const vector<string> &data) { sha1Batch(data); }, {1}},
+    {batchSha256, "sha256", [](const vector<string> &data) { sha256Batch(data); }, {1}},
+    {batchSha512, "sha512", [](const vector<string> &data) { sha512Batch(data); }, {1}},
+  };
+
+  if(cpuHasAVX2) {
+    candidates[batchMd2].lanes.push_back(32);
+    candidates[batchMd4].lanes.push_back(8);
+    candidates[batchMd5].lanes.push_back(8);
+    candidates[batchSha1].lanes.push_back(8);
+    candidates[batchSha256].lanes.push_back(8);
+    candidates[batchSha512].lanes.push_back(4);
+  }
 
-string sha512_224(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  uint128_t padLength = data.length() * 8; // Each character in the data is 8
-                                           // bits
-  uint128_t lengthHolder = padLength; // Saved for later to add to the end
-                                      // of the pad buffer
+  if(cpuHasAVX512)
+    candidates[batchSha512].lanes.push_back(8);
 
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (1024 * (padLength / 1024 + 1));
+  return candidates;
+}
 
-  if(lengthHolder + 1 > padLength - 128)
-    padLength += 1024;
+/*
+  Identifies the CPU model, and any tier forced on it, that a cache file was
+  written for
+*/
+string calibrationIdentity() {
+  unsigned int brand[12] = {};
+  unsigned int signature, ebx, ecx, edx;
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+  for(unsigned int leaf = 0; leaf < 3; ++leaf)
+    __get_cpuid(0x80000002 + leaf, &brand[leaf * 4], &brand[leaf * 4 + 1], &brand[leaf * 4 + 2],
+                &brand[leaf * 4 + 3]);
 
-  // Zero out pad buffer
-  for(uint128_t fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  if(!__get_cpuid(1, &signature, &ebx, &ecx, &edx))
+    signature = 0;
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  uint128_t padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+  ostringstream identity;
+  identity << hex << signature << ' ' << cpuTier.name << ' '
+           << string((const char *)brand, strnlen((const char *)brand, sizeof(brand)));
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+  return identity.str();
+}
+
+// Fastest of a few runs of function, in seconds
+template<typename Function>
+double fastestRun(Function function) {
+  double fastest = 1e9;
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+  for(short run = 0; run < 5; ++run) {
+    auto start = chrono::steady_clock::now();
+    function();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    fastest = min(fastest, elapsed.count());
+  }
 
-  // Fill pad with 0s until 128 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+  return fastest;
+}
 
-  padPos = padLength - 1;
+/*
+  Times every available kernel of each algorithm on a 64 KiB message,
+  installing the fastest and adding its name to installed, and every lane
+  count of each batch function on batches of messages from each size bucket.
+
+  Unlike the lane counts, the single block kernels are timed at one size
+  only and installed for every length. The contexts hand them one block at
+  a time without knowing how long the message will be, so there is no size
+  to pick a kernel by, and the cost per block doesn't depend on it.
+*/
+void measureKernels(vector<const char *> &installed) {
+  const string message(64 * 1024, 'a');
+  vector<KernelCandidate> candidates = kernelCandidates();
 
-  uint128_t val = lengthHolder;
-  uint128_t temp = 0;
+  for(const KernelAlgorithm &algorithm : kernelAlgorithms) {
+    const KernelCandidate *fastest = nullptr;
+    double fastestTime = 0;
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 127; ++bitPos) {
-    bool bit = val & ((uint128_t)1 << bitPos);
+    for(const KernelCandidate &candidate : candidates) {
+      if(strcmp(candidate.algorithm, algorithm.name) != 0 || !candidate.available)
+        continue;
 
-    padBuffer[padPos] = bit;
+      candidate.install();
+      double time = fastestRun([&] { algorithm.hash(message); });
 
-    if(bit) {
-      temp += 1ull << bitPos;
-      if(temp == val)
-        break;
+      if(fastest == nullptr || time < fastestTime) {
+        fastest = &candidate;
+        fastestTime = time;
+      }
     }
 
-    --padPos;
+    fastest->install();
+    installed.push_back(fastest->name);
   }
 
-  // Create constants array and initial state registers
-  uint64_t constants[80] = {0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
-                            0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
-                            0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
-                            0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
-                            0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
-                            0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
-                            0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
-                            0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
-                            0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
-                            0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
-                            0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
-                            0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
-                            0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
-                            0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
-                            0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
-                            0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
-                            0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
-                            0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
-                            0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
-                            0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-                            0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
-                            0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
-                            0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
-                            0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
-                            0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
-                            0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
-                            0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
-  
-  uint64_t stateRegisters[8];
-  stateRegisters[0] = 10105294471447203234; // 0x8c3d37c819544da2
-  stateRegisters[1] = 8350123849800275158;  // 0x73e1996689dcd4d6
-  stateRegisters[2] = 2160240930085379202;  // 0x1dfab7ae32ff9c82
-  stateRegisters[3] = 7466358040605728719;  // 0x679dd514582f9fcf
-  stateRegisters[4] = 1111592415079452072;  // 0x0f6d2b697bd44da8
-  stateRegisters[5] = 8638871050018654530;  // 0x77d36f7304c48942
-  stateRegisters[6] = 4583966954114332360;  // 0x3f9d85a86a1d36c8
-  stateRegisters[7] = 1230299281376055969;  // 0x1112e6ad91d692a1
-
-  // Process pad buffer in 1024 bit blocks
-  bool block[1024];
-
-  int blockTrack = 0;
-  uint64_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 1024) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint64_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      sha512processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      uint128_t tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 63; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-
-          if(registerStateSave[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-        }
+  // One representative length per size bucket, in enough messages to keep
+  // every lane busy for a while
+  const size_t bucketLengths[batchSizeBuckets] = {48, 512, 4096};
+  const size_t bucketMessages[batchSizeBuckets] = {512, 128, 32};
 
-        uint64_t newStateVal = tempVal % bigModulo;
+  for(const BatchCandidates &batch : batchCandidates()) {
+    for(short bucket = 0; bucket < batchSizeBuckets; ++bucket) {
+      const vector<string> data(bucketMessages[bucket], string(bucketLengths[bucket], 'a'));
+      short fastest = 0;
+      double fastestTime = 0;
 
-        stateRegisters[pointer] = newStateVal;
+      for(short lanes : batch.lanes) {
+        batchLanes[batch.algorithm][bucket] = lanes;
+        double time = fastestRun([&] { batch.hash(data); });
 
-        tempVal = 0;
+        if(fastest == 0 || time < fastestTime) {
+          fastest = lanes;
+          fastestTime = time;
+        }
       }
 
-      blockTrack = 0;
+      batchLanes[batch.algorithm][bucket] = fastest;
     }
   }
-
-  /* Convert resulting state registers to hexadecimal notation */
-
-  return hexDigest(stateRegisters, 4).substr(0, 56);
 }
 
-/*---------------------------------------------------------------------------*/
-/*                         Begin SHA512/256 Section                          */
-/*---------------------------------------------------------------------------*/
-
 /*
-  SHA512/224 is exactly the same as SHA512 and SHA384, accept for the
-  following changes:
-
-  - State registers are determined by the result of the SHA512/t IV Generation
-    function on the string "SHA512/256".
-  - Output is truncated to 256 bits
+  Installs the choices read from a cache file written by saveCalibration(),
+  returning false if it can't be read, belongs to another CPU or names
+  anything this one can't run
 */
+bool loadCalibration(const string &cachePath) {
+  ifstream file(cachePath);
+  string line;
 
-string sha512_256(string data) {
-  // Calculate the amount of bits needed to fill pad buffer
-  uint128_t padLength = data.length() * 8; // Each character in the data is 8
-                                           // bits
-  uint128_t lengthHolder = padLength; // Saved for later to add to the end
-                                      // of the pad buffer
-
-  // Calculates the exact size the pad buffer needs to be to fit all the bits
-  padLength = (1024 * (padLength / 1024 + 1));
+  if(!getline(file, line) || line != "hashes-calibration 1")
+    return false;
 
-  if(lengthHolder + 1 > padLength - 128)
-    padLength += 1024;
+  if(!getline(file, line) || line != "cpu " + calibrationIdentity())
+    return false;
 
-  // Create array to represent the pad buffer of bits
-  bool padBuffer[padLength];
+  vector<KernelCandidate> candidates = kernelCandidates();
+  vector<BatchCandidates> batches = batchCandidates();
+  size_t kernelsRead = 0;
+  size_t batchesRead = 0;
 
-  // Zero out pad buffer
-  for(uint128_t fill = 0; fill < padLength; ++fill)
-    padBuffer[fill] = 0;
+  while(getline(file, line)) {
+    istringstream fields(line);
+    string kind, algorithm;
+    fields >> kind >> algorithm;
 
-  /* Fill pad buffer */
-  // Fill with bits taken from every byte of the given data
-  uint128_t padPos = 0;
-  for(int dataPos = 0; dataPos < data.length(); ++dataPos) {
-    uint8_t dataVal = data.at(dataPos);
+    if(kind == "kernel") {
+      string name;
+      fields >> name;
 
-    for(int bitPos = 7; bitPos >= 0; --bitPos) {
-      padBuffer[padPos] = dataVal & (1l << bitPos);
-      ++padPos;
-    }
-  }
+      auto candidate = find_if(candidates.begin(), candidates.end(), [&](const KernelCandidate &option) {
+        return option.algorithm == algorithm && option.name == name && option.available;
+      });
 
-  // Add a 1 bit
-  padBuffer[padPos] = 1;
+      if(candidate == candidates.end())
+        return false;
 
-  // Fill pad with 0s until 128 bits of space remain:
-  // This is already done after we initialize the array
-  // since we zero it out to get rid of any garbage left
-  // in memory
+      candidate->install();
+      ++kernelsRead;
+    } else if(kind == "batch") {
+      auto batch = find_if(batches.begin(), batches.end(),
+                           [&](const BatchCandidates &option) { return option.name == algorithm; });
 
-  padPos = padLength - 1;
+      if(batch == batches.end())
+        return false;
 
-  uint128_t val = lengthHolder;
-  uint128_t temp = 0;
+      for(short bucket = 0; bucket < batchSizeBuckets; ++bucket) {
+        short lanes = 0;
 
-  // This makes sure that only the bits representing the bit size
-  // of the data is accurately inserted into pad buffer
-  for(int bitPos = 0; bitPos <= 127; ++bitPos) {
-    bool bit = val & ((uint128_t)1 << bitPos);
+        if(!(fields >> lanes) || find(batch->lanes.begin(), batch->lanes.end(), lanes) == batch->lanes.end())
+          return false;
 
-    padBuffer[padPos] = bit;
+        batchLanes[batch->algorithm][bucket] = lanes;
+      }
 
-    if(bit) {
-      temp += 1ull << bitPos;
-      if(temp == val)
-        break;
+      ++batchesRead;
+    } else {
+      return false;
     }
-
-    --padPos;
   }
 
-  // Create constants array and initial state registers
-  uint64_t constants[80] = {0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
-                            0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
-                            0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
-                            0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
-                            0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
-                            0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
-                            0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
-                            0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
-                            0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
-                            0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
-                            0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
-                            0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
-                            0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
-                            0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
-                            0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
-                            0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
-                            0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
-                            0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
-                            0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
-                            0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-                            0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
-                            0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
-                            0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
-                            0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
-                            0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
-                            0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
-                            0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
-  
-  uint64_t stateRegisters[8];
-  stateRegisters[0] = 2463787394917988140;  // 0x22312194fc2bf72c
-  stateRegisters[1] = 11481187982095705282; // 0x9f555fa3c84c64c2
-  stateRegisters[2] = 2563595384472711505;  // 0x2393b86b6f53b151
-  stateRegisters[3] = 10824532655140301501; // 0x963877195940eabd
-  stateRegisters[4] = 10819967247969091555; // 0x96283ee2a88effe3
-  stateRegisters[5] = 13717434660681038226; // 0xbe5e1e2553863992
-  stateRegisters[6] = 3098927326965381290;  // 0x2b0199fc2c85b8aa
-  stateRegisters[7] = 1060366662362279074;  // 0x0eb72ddc81c52ca2
-
-  // Process pad buffer in 1024 bit blocks
-  bool block[1024];
-
-  int blockTrack = 0;
-  uint64_t registerStateSave[8];
-  for(int bitCount = 0; bitCount < padLength; ++bitCount) {
-    block[blockTrack] = padBuffer[bitCount];
-    ++blockTrack;
-
-    if(blockTrack == 1024) {
-      // Save the state of the current registers
-      short pos = 0;
-      for(uint64_t val: stateRegisters)
-        registerStateSave[pos++] = val;
-
-      sha512processBlock(block, stateRegisters, constants);
-
-      // Add saved register state to the newly processed register state to
-      // obtain the final resulting register state of the current iteration
-      uint128_t tempVal = 0;
-      for(short pointer = 0; pointer < 8; ++pointer) {
-        for(short bitPos = 63; bitPos >= 0; --bitPos) {
-          if(stateRegisters[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-
-          if(registerStateSave[pointer] & (1ull << bitPos))
-            tempVal += 1ull << bitPos;
-        }
+  return kernelsRead == size(kernelAlgorithms) && batchesRead == batches.size();
+}
+
+/*
+  Writes out the names of the installed kernels, in the order measureKernels()
+  gives them, and the batch lane counts, one algorithm per line beneath the
+  CPU they were measured on
+*/
+void saveCalibration(const string &cachePath, const vector<const char *> &installed) {
+  ofstream file(cachePath);
 
-        uint64_t newStateVal = tempVal % bigModulo;
+  file << "hashes-calibration 1\n";
+  file << "cpu " << calibrationIdentity() << "\n";
 
-        stateRegisters[pointer] = newStateVal;
+  for(size_t pos = 0; pos < installed.size(); ++pos)
+    file << "kernel " << kernelAlgorithms[pos].name << ' ' << installed[pos] << "\n";
 
-        tempVal = 0;
-      }
+  for(const BatchCandidates &batch : batchCandidates()) {
+    file << "batch " << batch.name;
 
-      blockTrack = 0;
-    }
+    for(short bucket = 0; bucket < batchSizeBuckets; ++bucket)
+      file << ' ' << batchLanes[batch.algorithm][bucket];
+
+    file << "\n";
   }
+}
+
+#endif
+
+void calibrateKernels(const string &cachePath) {
+#if defined(__x86_64__) || defined(__i386__)
+  if(!cachePath.empty() && loadCalibration(cachePath))
+    return;
 
-  /* Convert resulting state registers to hexadecimal notation */
+  vector<const char *> installed;
+  measureKernels(installed);
 
-  return hexDigest(stateRegisters, 4);
+  if(!cachePath.empty())
+    saveCalibration(cachePath, installed);
+#endif
 }
 
 /*---------------------------------------------------------------------------*/
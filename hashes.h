@@ -1,15 +1,371 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 using namespace std;
 
-string md2(string data);
-string md4(string data);
-string md5(string data);
-string sha0(string data);
-string sha1(string data);
-string sha224(string data);
-string sha256(string data);
-string sha384(string data);
-string sha512(string data);
-string sha512_224(string data);
-string sha512_256(string data);
\ No newline at end of file
+/*
+  Binary digests, holding the hash as raw bytes in the order they appear in
+  the hex digest
+*/
+template<size_t size>
+using Digest = array<uint8_t, size>;
+
+string md2(string_view data);
+string md4(string_view data);
+string md5(string_view data);
+string sha0(string_view data);
+string sha1(string_view data);
+string sha224(string_view data);
+string sha256(string_view data);
+string sha384(string_view data);
+string sha512(string_view data);
+string sha512_224(string_view data);
+string sha512_256(string_view data);
+string sha512_t(string_view data, int t);
+
+Digest<16> md2Digest(string_view data);
+Digest<16> md4Digest(string_view data);
+Digest<16> md5Digest(string_view data);
+Digest<20> sha0Digest(string_view data);
+Digest<20> sha1Digest(string_view data);
+Digest<28> sha224Digest(string_view data);
+Digest<32> sha256Digest(string_view data);
+Digest<48> sha384Digest(string_view data);
+Digest<64> sha512Digest(string_view data);
+Digest<28> sha512_224Digest(string_view data);
+Digest<32> sha512_256Digest(string_view data);
+void sha512_tDigest(string_view data, int t, uint8_t digest[]); // Writes t / 8 bytes
+
+/*
+  The same functions reading length bytes straight from data, so that
+  buffers which aren't strings are hashed in place
+*/
+string md2(const void *data, size_t length);
+string md4(const void *data, size_t length);
+string md5(const void *data, size_t length);
+string sha0(const void *data, size_t length);
+string sha1(const void *data, size_t length);
+string sha224(const void *data, size_t length);
+string sha256(const void *data, size_t length);
+string sha384(const void *data, size_t length);
+string sha512(const void *data, size_t length);
+string sha512_224(const void *data, size_t length);
+string sha512_256(const void *data, size_t length);
+string sha512_t(const void *data, size_t length, int t);
+
+Digest<16> md2Digest(const void *data, size_t length);
+Digest<16> md4Digest(const void *data, size_t length);
+Digest<16> md5Digest(const void *data, size_t length);
+Digest<20> sha0Digest(const void *data, size_t length);
+Digest<20> sha1Digest(const void *data, size_t length);
+Digest<28> sha224Digest(const void *data, size_t length);
+Digest<32> sha256Digest(const void *data, size_t length);
+Digest<48> sha384Digest(const void *data, size_t length);
+Digest<64> sha512Digest(const void *data, size_t length);
+Digest<28> sha512_224Digest(const void *data, size_t length);
+Digest<32> sha512_256Digest(const void *data, size_t length);
+void sha512_tDigest(const void *data, size_t length, int t, uint8_t digest[]); // Writes t / 8 bytes
+
+// And for spans of bytes, when compiled as C++20
+#if __cplusplus >= 202002L
+inline string md2(span<const byte> data) { return md2(data.data(), data.size()); }
+inline string md4(span<const byte> data) { return md4(data.data(), data.size()); }
+inline string md5(span<const byte> data) { return md5(data.data(), data.size()); }
+inline string sha0(span<const byte> data) { return sha0(data.data(), data.size()); }
+inline string sha1(span<const byte> data) { return sha1(data.data(), data.size()); }
+inline string sha224(span<const byte> data) { return sha224(data.data(), data.size()); }
+inline string sha256(span<const byte> data) { return sha256(data.data(), data.size()); }
+inline string sha384(span<const byte> data) { return sha384(data.data(), data.size()); }
+inline string sha512(span<const byte> data) { return sha512(data.data(), data.size()); }
+inline string sha512_224(span<const byte> data) { return sha512_224(data.data(), data.size()); }
+inline string sha512_256(span<const byte> data) { return sha512_256(data.data(), data.size()); }
+inline string sha512_t(span<const byte> data, int t) { return sha512_t(data.data(), data.size(), t); }
+
+inline Digest<16> md2Digest(span<const byte> data) { return md2Digest(data.data(), data.size()); }
+inline Digest<16> md4Digest(span<const byte> data) { return md4Digest(data.data(), data.size()); }
+inline Digest<16> md5Digest(span<const byte> data) { return md5Digest(data.data(), data.size()); }
+inline Digest<20> sha0Digest(span<const byte> data) { return sha0Digest(data.data(), data.size()); }
+inline Digest<20> sha1Digest(span<const byte> data) { return sha1Digest(data.data(), data.size()); }
+inline Digest<28> sha224Digest(span<const byte> data) { return sha224Digest(data.data(), data.size()); }
+inline Digest<32> sha256Digest(span<const byte> data) { return sha256Digest(data.data(), data.size()); }
+inline Digest<48> sha384Digest(span<const byte> data) { return sha384Digest(data.data(), data.size()); }
+inline Digest<64> sha512Digest(span<const byte> data) { return sha512Digest(data.data(), data.size()); }
+inline Digest<28> sha512_224Digest(span<const byte> data) { return sha512_224Digest(data.data(), data.size()); }
+inline Digest<32> sha512_256Digest(span<const byte> data) { return sha512_256Digest(data.data(), data.size()); }
+inline void sha512_tDigest(span<const byte> data, int t, uint8_t digest[]) {
+  sha512_tDigest(data.data(), data.size(), t, digest);
+}
+#endif
+
+/*
+  Batch interface, hashing many independent messages in one call and
+  returning their digests in the same order. Where the CPU allows, several
+  messages are run side by side in the lanes of vector registers. Besides
+  a vector of strings, a batch can be given as count views of buffers held
+  elsewhere.
+*/
+vector<Digest<16>> md2Batch(const vector<string> &data);
+vector<Digest<16>> md2Batch(const string_view data[], size_t count);
+vector<Digest<16>> md4Batch(const vector<string> &data);
+vector<Digest<16>> md4Batch(const string_view data[], size_t count);
+vector<Digest<16>> md5Batch(const vector<string> &data);
+vector<Digest<16>> md5Batch(const string_view data[], size_t count);
+vector<Digest<20>> sha1Batch(const vector<string> &data);
+vector<Digest<20>> sha1Batch(const string_view data[], size_t count);
+vector<Digest<28>> sha224Batch(const vector<string> &data);
+vector<Digest<28>> sha224Batch(const string_view data[], size_t count);
+vector<Digest<32>> sha256Batch(const vector<string> &data);
+vector<Digest<32>> sha256Batch(const string_view data[], size_t count);
+vector<Digest<48>> sha384Batch(const vector<string> &data);
+vector<Digest<48>> sha384Batch(const string_view data[], size_t count);
+vector<Digest<64>> sha512Batch(const vector<string> &data);
+vector<Digest<64>> sha512Batch(const string_view data[], size_t count);
+vector<Digest<28>> sha512_224Batch(const vector<string> &data);
+vector<Digest<28>> sha512_224Batch(const string_view data[], size_t count);
+vector<Digest<32>> sha512_256Batch(const vector<string> &data);
+vector<Digest<32>> sha512_256Batch(const string_view data[], size_t count);
+
+/*
+  Optional calibration, timing every kernel the CPU supports for each
+  algorithm, and every lane count of the batch functions over a few sizes of
+  message, then using the fastest from then on. It takes a fraction of a
+  second and must not run while other threads are hashing.
+
+  Given a cachePath, the choices are read from that file instead if it was
+  written on the same model of CPU, or otherwise measured and saved there.
+  Failing to save them isn't an error.
+*/
+void calibrateKernels(const string &cachePath = "");
+
+/*
+  Writes the hex encoding of length bytes into output, which must have room
+  for 2 * length characters. No terminating null is added.
+*/
+void hexEncode(const uint8_t bytes[], size_t length, char output[]);
+
+/*
+  Hex encodes count digests of digestLength bytes each, stored back to back,
+  starting each one outputStride characters after the previous. A stride of
+  2 * digestLength + 1 leaves room for a separator after every digest.
+*/
+void hexEncodeDigests(const uint8_t digests[], size_t digestLength, size_t count, char output[],
+                      size_t outputStride);
+
+/*
+  Decodes length hex characters (upper or lower case) into length / 2 bytes.
+  Returns false if length is odd or any character isn't a hex digit, in which
+  case the contents of bytes are unspecified.
+*/
+bool hexDecode(const char hex[], size_t length, uint8_t bytes[]);
+
+/*
+  Incremental hashing contexts
+
+  Each context only holds the chaining registers of its algorithm and a single
+  partially filled block, so a message can be fed in any number of pieces
+  through update() and hashed in constant memory. finalize() pads the message
+  and returns the hex digest, or finalizeDigest() the binary one, after which
+  the context must not be reused.
+*/
+
+class Md2Ctx {
+public:
+  Md2Ctx();
+
+  void update(const void *data, size_t length);
+  void update(string_view data);
+#if __cplusplus >= 202002L
+  void update(span<const byte> data) { update(data.data(), data.size()); }
+#endif
+  string finalize();
+  Digest<16> finalizeDigest();
+
+private:
+  void processBlock(const uint8_t block[]);
+
+  uint8_t messageDigest[48];
+  uint8_t checkSum[16];
+  uint8_t checkSumLast;
+  uint8_t buffer[16];
+  size_t bufferLength;
+};
+
+/*
+  Context shared by the Merkle-Damgard hashes, which differ only in the
+  properties given by their traits: the chaining register type and count,
+  the block size, the width and byte order of the length field that ends the
+  padding (the digest uses the same byte order), the digest size, the
+  starting register values and the compression function. Passing starting
+  registers to the constructor overrides the ones in the traits.
+*/
+template<typename Traits>
+class MerkleDamgardCtx {
+public:
+  MerkleDamgardCtx();
+  explicit MerkleDamgardCtx(const typename Traits::Word startingState[]);
+
+  void update(const void *data, size_t length);
+  void update(string_view data);
+#if __cplusplus >= 202002L
+  void update(span<const byte> data) { update(data.data(), data.size()); }
+#endif
+  string finalize();
+  Digest<Traits::digestSize> finalizeDigest();
+
+private:
+  typename Traits::Word registers[Traits::stateWords];
+  uint8_t buffer[Traits::blockSize];
+  size_t bufferLength;
+  uint64_t messageLength;
+};
+
+struct Md4Traits {
+  typedef uint32_t Word;
+  static const size_t blockSize = 64;
+  static const size_t lengthBytes = 8;
+  static const bool bigEndian = false;
+  static const size_t stateWords = 4;
+  static const size_t digestSize = 16;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Md4Ctx = MerkleDamgardCtx<Md4Traits>;
+
+struct Md5Traits {
+  typedef uint32_t Word;
+  static const size_t blockSize = 64;
+  static const size_t lengthBytes = 8;
+  static const bool bigEndian = false;
+  static const size_t stateWords = 4;
+  static const size_t digestSize = 16;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Md5Ctx = MerkleDamgardCtx<Md5Traits>;
+
+struct Sha0Traits {
+  typedef uint32_t Word;
+  static const size_t blockSize = 64;
+  static const size_t lengthBytes = 8;
+  static const bool bigEndian = true;
+  static const size_t stateWords = 5;
+  static const size_t digestSize = 20;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Sha0Ctx = MerkleDamgardCtx<Sha0Traits>;
+
+struct Sha1Traits {
+  typedef uint32_t Word;
+  static const size_t blockSize = 64;
+  static const size_t lengthBytes = 8;
+  static const bool bigEndian = true;
+  static const size_t stateWords = 5;
+  static const size_t digestSize = 20;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Sha1Ctx = MerkleDamgardCtx<Sha1Traits>;
+
+struct Sha256Traits {
+  typedef uint32_t Word;
+  static const size_t blockSize = 64;
+  static const size_t lengthBytes = 8;
+  static const bool bigEndian = true;
+  static const size_t stateWords = 8;
+  static const size_t digestSize = 32;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Sha256Ctx = MerkleDamgardCtx<Sha256Traits>;
+
+/*
+  The truncated variants run the SHA256 or SHA512 core unchanged, only
+  starting from their own registers and keeping fewer bytes of the result
+*/
+struct Sha224Traits : Sha256Traits {
+  static const size_t digestSize = 28;
+
+  static const Word *startingState();
+};
+
+using Sha224Ctx = MerkleDamgardCtx<Sha224Traits>;
+
+struct Sha512Traits {
+  typedef uint64_t Word;
+  static const size_t blockSize = 128;
+  static const size_t lengthBytes = 16;
+  static const bool bigEndian = true;
+  static const size_t stateWords = 8;
+  static const size_t digestSize = 64;
+
+  static const Word *startingState();
+  static void processBlock(const uint8_t block[], Word registers[]);
+};
+
+using Sha512Ctx = MerkleDamgardCtx<Sha512Traits>;
+
+struct Sha384Traits : Sha512Traits {
+  static const size_t digestSize = 48;
+
+  static const Word *startingState();
+};
+
+using Sha384Ctx = MerkleDamgardCtx<Sha384Traits>;
+
+struct Sha512_224Traits : Sha512Traits {
+  static const size_t digestSize = 28;
+
+  static const Word *startingState();
+};
+
+using Sha512_224Ctx = MerkleDamgardCtx<Sha512_224Traits>;
+
+struct Sha512_256Traits : Sha512Traits {
+  static const size_t digestSize = 32;
+
+  static const Word *startingState();
+};
+
+using Sha512_256Ctx = MerkleDamgardCtx<Sha512_256Traits>;
+
+/*
+  t is the digest length in bits; any multiple of 8 from 8 to 504 other than
+  384 is accepted, anything else throws invalid_argument
+*/
+class Sha512_tCtx {
+public:
+  Sha512_tCtx(int t);
+
+  void update(const void *data, size_t length);
+  void update(string_view data);
+#if __cplusplus >= 202002L
+  void update(span<const byte> data) { update(data.data(), data.size()); }
+#endif
+  string finalize();
+  void finalizeDigest(uint8_t digest[]); // Writes t / 8 bytes
+
+private:
+  MerkleDamgardCtx<Sha512Traits> core;
+  int digestLength;
+};
@@ -1,8 +1,22 @@
 #include "hashes.h"
+#include <cctype>
 #include <iostream>
 
 using namespace std;
 
+// Compares every digest of a batch against hashing its message on its own
+template<typename Digests, typename Single>
+const char *batchResult(const Digests &digests, const vector<string> &messages, Single single) {
+  if(digests.size() != messages.size())
+    return "mismatch";
+
+  for(size_t pos = 0; pos < messages.size(); ++pos)
+    if(digests[pos] != single(messages[pos]))
+      return "mismatch";
+
+  return "batch matches";
+}
+
 int main() {
   cout << "       MD2: " << md2("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
   cout << "       MD4: " << md4("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
@@ -15,6 +29,63 @@ int main() {
   cout << "    SHA512: " << sha512("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
   cout << "SHA512/224: " << sha512_224("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
   cout << "SHA512/256: " << sha512_256("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
+  cout << "SHA512/200: " << sha512_t("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 200) << endl;
+
+  // The same message fed through an incremental context in two pieces
+  Sha256Ctx ctx;
+  ctx.update("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  ctx.update("abcdefghijklmnopqrstuvwxyz0123456789");
+  cout << "SHA256 ctx: " << ctx.finalize() << endl;
+
+  // Buffers that aren't strings are hashed in place
+  const char buffer[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+  cout << "SHA256 buf: " << sha256(buffer, sizeof(buffer) - 1) << endl;
+
+  // Binary digests can be compared directly and hex encoded on demand
+  Digest<32> digest = sha256Digest("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
+  char hex[64];
+  hexEncode(digest.data(), digest.size(), hex);
+  cout << "SHA256 raw: " << string(hex, 64) << endl;
+
+  // Expected digests given in hex, in either case, decode back to the same bytes
+  string upper(hex, 64);
+  for(char &c : upper)
+    c = toupper(c);
+  Digest<32> decoded;
+  bool valid = hexDecode(upper.data(), upper.size(), decoded.data());
+  cout << "SHA256 hex: " << (valid && decoded == digest ? "round trip" : "mismatch") << endl;
+
+  // Batches of independent messages are hashed side by side, with more
+  // messages than lanes so that finished lanes get refilled. The lengths
+  // vary from empty to several blocks, so lanes finish at different times.
+  vector<string> messages;
+  for(short pos = 0; pos < 40; ++pos) {
+    string message((pos * 53) % 700, 'A' + pos % 26);
+    for(size_t letter = 0; letter < message.size(); letter += 7)
+      message[letter] = 'a' + letter % 26;
+    messages.push_back(message);
+  }
+
+  cout << "   MD2 bat: " << batchResult(md2Batch(messages), messages,
+                                        [](const string &message) { return md2Digest(message); }) << endl;
+  cout << "   MD4 bat: " << batchResult(md4Batch(messages), messages,
+                                        [](const string &message) { return md4Digest(message); }) << endl;
+  cout << "   MD5 bat: " << batchResult(md5Batch(messages), messages,
+                                        [](const string &message) { return md5Digest(message); }) << endl;
+  cout << "  SHA1 bat: " << batchResult(sha1Batch(messages), messages,
+                                        [](const string &message) { return sha1Digest(message); }) << endl;
+  cout << "SHA256 bat: " << batchResult(sha256Batch(messages), messages,
+                                        [](const string &message) { return sha256Digest(message); }) << endl;
+  cout << "SHA512 bat: " << batchResult(sha512Batch(messages), messages,
+                                        [](const string &message) { return sha512Digest(message); }) << endl;
+
+  // Calibration only changes which kernels run, never the digests
+  calibrateKernels();
+  cout << "SHA256 cal: " << sha256("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") << endl;
+
+  // Inputs far larger than the stack are hashed in constant memory
+  string large(64 * 1024 * 1024, 'a');
+  cout << "SHA256 64M: " << sha256(large) << endl;
 
   return 0;
 }